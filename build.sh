@@ -1,22 +1,57 @@
 #!/usr/bin/env bash
 set -e
 
+# Profiles:
+#   wasm          (default) WASM module + JS package in dist/
+#   native        native shared library, scalar VPU
+#   native-sse4.1 native shared library, SSE4.1 VPU kernels
+#   native-avx2   same kernels, VEX-encoded
+#   native-crosscheck  runs both VPU implementations for every instruction and compares them
+# Native hosts pick one of the libraries at load time and have to check the CPU themselves before loading it.
+PROFILE=${1:-wasm}
+
+WARNINGS="\
+  -Wall \
+  -pedantic-errors \
+  -Wno-logical-op-parentheses \
+  -Wno-shift-op-parentheses \
+  -Wno-bitwise-op-parentheses \
+  -Wno-gnu-anonymous-struct"
+
+case "$PROFILE" in
+  native)        NATIVE_FLAGS="" ;;
+  native-sse4.1) NATIVE_FLAGS="-msse4.1" ;;
+  native-avx2)   NATIVE_FLAGS="-mavx2" ;;
+  native-crosscheck) NATIVE_FLAGS="-msse4.1 -DRSP_VPU_CROSSCHECK" ;;
+  wasm) ;;
+  *) echo "Unknown profile: $PROFILE"; exit 1 ;;
+esac
+
+if [ "$PROFILE" != "wasm" ]; then
+  clang++ -std=c++20 -O3 -shared -fPIC $NATIVE_FLAGS \
+    -flto -fno-exceptions -fno-rtti \
+    $WARNINGS \
+    -Wno-unknown-attributes \
+    -o "librsp-$PROFILE.so" \
+    src/main.cpp
+  exit 0
+fi
+
 clang++ -nostdlib --target=wasm32 -std=c++20 \
   -O3 \
   -msign-ext \
   -mmultivalue \
   -mbulk-memory \
   -msimd128 \
+  -mtail-call \
   -mnontrapping-fptoint \
-  -Wall \
-  -flto -pedantic-errors -fno-exceptions -fno-rtti \
-  -Wno-logical-op-parentheses \
-  -Wno-shift-op-parentheses \
-  -Wno-bitwise-op-parentheses \
-  -Wno-gnu-anonymous-struct \
+  -flto -fno-exceptions -fno-rtti \
+  $WARNINGS \
   \
   -Wl,--no-entry \
   -Wl,--export-dynamic \
+  -Wl,--export-table \
+  -Wl,--growable-table \
   -Wl,--fatal-warnings \
   -Wl,--allow-undefined \
   -Wl,--lto-O3 \
@@ -31,4 +66,3 @@ cp rspjs.js dist/index.js
 cp rsp.wasm dist/
 cp package.json dist/
 cp Readme.md dist/README.md
-
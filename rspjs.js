@@ -1,5 +1,3 @@
-import {readFile} from 'fs/promises';
-
 export const REGS_SCALAR = [
   "$zero", "$at", "$v0", "$v1", "$a0", "$a1", "$a2", "$a3",
   "$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7",
@@ -23,33 +21,117 @@ export const REG_MAP = {};
 for(let i=0; i<REGS_VECTOR.length; ++i) {
   REG_MAP[REGS_VECTOR[i]] = i;
 }
+
 for(let i=0; i<REGS_SCALAR.length; ++i) {
   REG_MAP[REGS_SCALAR[i]] = i;
 }
 
+// $vcoh - $vce are stored as one byte each (bit n = element n) right after the accumulator
+const REG_VCX_FIRST = REG_MAP["$vcoh"];
+
+// HostEvents::Kind
+export const RSP_EVENTS = ['break', 'interrupt', 'signal'];
+
+// a module that imports "e"."f" as '(i32, i32) => void' and exports it again,
+// which turns a JS function into one that can go into the RSP module's function table
+const EVENT_TRAMPOLINE = new Uint8Array([
+  0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+  0x01, 0x06, 0x01, 0x60, 0x02, 0x7f, 0x7f, 0x00,        // type: (i32, i32) => ()
+  0x02, 0x07, 0x01, 0x01, 0x65, 0x01, 0x66, 0x00, 0x00,  // import: e.f
+  0x07, 0x05, 0x01, 0x01, 0x66, 0x00, 0x00,              // export: f
+]);
+let eventTrampoline;
+
+function wasmEventFunction(fn) {
+  eventTrampoline ??= new WebAssembly.Module(EVENT_TRAMPOLINE);
+  return new WebAssembly.Instance(eventTrampoline, {e: {f: fn}}).exports.f;
+}
+
+const IS_NODE = typeof process !== 'undefined' && !!process.versions?.node;
+const POOL_WORKER_PARAM = 'rsp-pool-worker';
+
 class RSP {
-  constructor(wasmModule) {
-    this.fn = wasmModule.instance.exports;
-    const wasmMemBuff = wasmModule.instance.exports.memory.buffer;
+  constructor(wasmInstance) {
+    this.fn = wasmInstance.exports;
+    const wasmMemBuff = wasmInstance.exports.memory.buffer;
 
     this.fn.rsp_init();
     this.fn.rsp_set_halted(0);
+    this.sliceCycles = SLICE_CYCLES_MIN;
+    this.dirtyDMEM = 0;
+    this.timelineInterval = 0;
+    this.eventHandler = null;
+    this.eventSlot = 0;
 
     this.GPR = new DataView(wasmMemBuff, this.fn.rsp_ptr_gpr());
     this.VPR = new DataView(wasmMemBuff, this.fn.rsp_ptr_vpr());
     this.IMEM = new DataView(wasmMemBuff, this.fn.rsp_ptr_imem());
     this.DMEM = new DataView(wasmMemBuff, this.fn.rsp_ptr_dmem());
+    this.RDRAM = new Uint8Array(wasmMemBuff, this.fn.rsp_ptr_rdram(), this.fn.rsp_rdram_size());
   }
 
   reset() {
     this.fn.rsp_init();
+    this.fn.rsp_timeline_enable(this.timelineInterval);
     this.fn.rsp_set_halted(0);
+    this.dirtyDMEM = 0;
   }
 
   step(count = 1) { 
+    if(this.timelineInterval)this.#syncDirty();
     this.fn.rsp_step(count); 
   }
 
+  /**
+   * Runs until the RSP halts (e.g. via 'break') or the cycle budget is used up.
+   * @param {number} maxCycles
+   * @returns {number} cycles executed
+   */
+  run(maxCycles) {
+    if(this.timelineInterval)this.#syncDirty();
+    return this.fn.rsp_run(maxCycles >>> 0);
+  }
+
+  /**
+   * Lets a halted RSP sit idle for 'cycles' (0: until the next pending event, e.g. a DMA row),
+   * without paying per cycle. Hosts scheduling the RSP next to other components use this for its idle time.
+   * @param {number} cycles
+   * @returns {number} cycles passed, 0 if the RSP isn't halted
+   */
+  idle(cycles = 0) {
+    if(this.timelineInterval)this.#syncDirty();
+    return this.fn.rsp_idle(cycles >>> 0);
+  }
+
+  /**
+   * Runs in time-sliced chunks, yielding to the event loop in between.
+   * The cycles per slice adapt to take roughly 'sliceMs' each.
+   * @param {{maxCycles?: number, sliceMs?: number, signal?: AbortSignal}} options
+   * @returns {Promise<{reason: 'halted'|'maxCycles'|'aborted', cycles: number}>}
+   */
+  async runUntil({maxCycles = Infinity, sliceMs = 8, signal} = {}) {
+    let cycles = 0;
+    for(;;) {
+      if(this.getStatus() & 1)return {reason: 'halted', cycles};
+      if(cycles >= maxCycles)return {reason: 'maxCycles', cycles};
+      if(signal?.aborted)return {reason: 'aborted', cycles};
+
+      const budget = Math.min(this.sliceCycles, maxCycles - cycles, 0xFFFF_FFFF);
+      const timeStart = performance.now();
+      cycles += this.run(budget);
+      const timeSlice = performance.now() - timeStart;
+
+      // only adapt on full slices, a halt mid-slice says nothing about speed
+      if(budget === this.sliceCycles && !(this.getStatus() & 1)) {
+        const target = timeSlice > 0 ? budget * sliceMs / timeSlice : budget * 2;
+        this.sliceCycles = Math.round(Math.min(Math.max(
+          (this.sliceCycles + target) / 2, SLICE_CYCLES_MIN), SLICE_CYCLES_MAX
+        ));
+      }
+      await yieldToEventLoop();
+    }
+  }
+
   /**
    * Reads a scalar register
    * @param {number|string} reg
@@ -78,6 +160,11 @@ class RSP {
   getVPR(reg) {
     if(typeof(reg) === 'string')reg = REG_MAP[reg];
     const res = [];
+    if(reg >= REG_VCX_FIRST) {
+      const bits = this.VPR.getUint8(REG_VCX_FIRST * 16 + reg - REG_VCX_FIRST);
+      for(let i=0; i<8; ++i)res[i] = (bits >> i) & 1 ? 0xFFFF : 0;
+      return res;
+    }
     for(let i=0; i<8; ++i) {
       res[7-i] = this.VPR.getUint16(reg * 16 + i*2, true);
     }
@@ -91,6 +178,12 @@ class RSP {
    */
   setVPR(reg, values) {
     if(typeof(reg) === 'string')reg = REG_MAP[reg];
+    if(reg >= REG_VCX_FIRST) {
+      let bits = 0;
+      for(let i=0; i<8; ++i)bits |= (values[i] ? 1 : 0) << i;
+      this.VPR.setUint8(REG_VCX_FIRST * 16 + reg - REG_VCX_FIRST, bits);
+      return;
+    }
     for(let i=0; i<8; ++i) {
       this.VPR.setUint16(reg * 16 + i*2, values[7-i] >>> 0, true);
     }
@@ -104,6 +197,14 @@ class RSP {
     return this.GPR.getUint32(32 * 4, true);
   }
 
+  /**
+   * Sets the PC, e.g. to start at an entry point other than 0
+   * @param {number} pc
+   */
+  setPC(pc) {
+    this.GPR.setUint16(32 * 4, pc & 0xFFC, true);
+  }
+
   /**
    * Current cycles
    * @returns {number}
@@ -112,6 +213,31 @@ class RSP {
     return this.fn.rsp_get_cycles();
   }
 
+  /**
+   * SP_STATUS register (bit 0: halted, bit 1: broken, ...)
+   * @returns {number}
+   */
+  getStatus() {
+    return this.fn.rsp_get_status();
+  }
+
+  /**
+   * Writes SP_STATUS the way the CPU does (set/clear bit pairs for halt, interrupt and signals)
+   * @param {number} value
+   */
+  setStatus(value) {
+    this.fn.rsp_set_status(value >>> 0);
+  }
+
+  /**
+   * Functional mode skips the pipeline model (stalls, dual issue),
+   * registers and memory end up the same, cycle counts don't.
+   * @param {boolean} enabled
+   */
+  setFunctional(enabled) {
+    this.fn.rsp_set_functional(enabled ? 1 : 0);
+  }
+
   dmemReadU8(addr) {
     let addrLE = (addr & ~0b11) | (3-(addr & 0b11));
     return this.DMEM.getUint8(addrLE);
@@ -120,6 +246,7 @@ class RSP {
   dmemWriteU8(addr, value) {
     let addrLE = (addr & ~0b11) | (3-(addr & 0b11));
     this.DMEM.setUint8(addrLE, value >>> 0);
+    this.dirtyDMEM |= 1 << (addr >> 8 & 15);
   }
 
   imemReadU8(addr) {
@@ -130,25 +257,348 @@ class RSP {
   imemWriteU8(addr, value) {
     let addrLE = (addr & ~0b11) | (3-(addr & 0b11));
     this.IMEM.setUint8(addrLE, value >>> 0);
+    this.fn.rsp_mark_dirty(1 << (addr >> 8 & 15), 0);
+  }
+
+  /**
+   * Copies a big-endian image (e.g. assembler output) into IMEM
+   * @param {ArrayBuffer|ArrayBufferView} data
+   * @param {number} offset
+   */
+  loadIMEM(data, offset = 0) {
+    // IMEM pages are flagged right away, cached timing blocks check their generation
+    this.fn.rsp_mark_dirty(copyToLE(this.IMEM, data, offset), 0);
+  }
+
+  /**
+   * Copies a big-endian image into DMEM
+   * @param {ArrayBuffer|ArrayBufferView} data
+   * @param {number} offset
+   */
+  loadDMEM(data, offset = 0) {
+    this.dirtyDMEM |= copyToLE(this.DMEM, data, offset);
+  }
+
+  /**
+   * Returns a big-endian copy of IMEM
+   * @returns {Uint8Array}
+   */
+  readIMEM() {
+    return copyFromLE(this.IMEM);
+  }
+
+  /**
+   * Returns a big-endian copy of DMEM
+   * @returns {Uint8Array}
+   */
+  readDMEM() {
+    return copyFromLE(this.DMEM);
+  }
+
+  /**
+   * Copies big-endian data into RDRAM, where DMAs started by the RSP read from.
+   * RDRAM is not touched by reset() and not part of contexts or the timeline.
+   * @param {ArrayBuffer|ArrayBufferView} data
+   * @param {number} address
+   */
+  loadRDRAM(data, address = 0) {
+    const src = ArrayBuffer.isView(data)
+      ? new Uint8Array(data.buffer, data.byteOffset, data.byteLength)
+      : new Uint8Array(data);
+    this.RDRAM.set(src.subarray(0, Math.max(this.RDRAM.length - address, 0)), address);
+  }
+
+  /**
+   * Returns a copy of a range of RDRAM (big-endian), e.g. the result of a DMA write
+   * @param {number} address
+   * @param {number} length
+   * @returns {Uint8Array}
+   */
+  readRDRAM(address, length) {
+    return this.RDRAM.slice(address, address + length);
+  }
+
+  /**
+   * DMA profile since the last reset: cycles spent spinning on SP_DMA_BUSY/SP_DMA_FULL,
+   * and the last transfers (times in cycles, 'end' is 0 while still in flight).
+   * @returns {{waitBusy: number, waitFull: number, count: number, transfers: Array<Object>}}
+   */
+  getDMAStats() {
+    const view = new DataView(this.fn.memory.buffer, this.fn.rsp_dma_stats_ptr());
+    const count = view.getUint32(16, true);
+    const transfers = [];
+    for(let i=Math.max(count - DMA_LOG_SIZE, 0); i<count; ++i) {
+      const offset = 24 + (i % DMA_LOG_SIZE) * 48;
+      const pbus = view.getUint32(offset + 28, true);
+      transfers.push({
+        queued: Number(view.getBigInt64(offset, true)),
+        start: Number(view.getBigInt64(offset + 8, true)),
+        end: Number(view.getBigInt64(offset + 16, true)),
+        dramAddress: view.getUint32(offset + 24, true),
+        memAddress: pbus & 0xFFF,
+        imem: !!(pbus & 0x1000),
+        length: view.getUint32(offset + 32, true),
+        rows: view.getUint32(offset + 36, true),
+        skip: view.getUint32(offset + 40, true),
+        write: !!view.getUint32(offset + 44, true),
+      });
+    }
+    return {
+      waitBusy: Number(view.getBigInt64(0, true)),
+      waitFull: Number(view.getBigInt64(8, true)),
+      count, transfers,
+    };
+  }
+
+  resetDMAStats() {
+    this.fn.rsp_dma_stats_reset();
+  }
+
+  /**
+   * RDP commands the RSP submitted via DPC_START/DPC_END since the last reset, with the cycle of each submission.
+   * The RDP isn't emulated, every submission is taken at once. 'overflow' counts submissions dropped since the buffer was full.
+   * @returns {{submissions: Array<{clock: number, commands: BigUint64Array}>, triangles: number, overflow: number}}
+   */
+  getRDPCapture() {
+    const base = this.fn.rsp_rdp_capture_ptr();
+    const view = new DataView(this.fn.memory.buffer, base);
+    const count = view.getUint32(4, true);
+    const commands = new BigUint64Array(this.fn.memory.buffer, base + RDP_CAPTURE_COMMANDS, view.getUint32(0, true));
+    const submissions = [];
+    for(let i=0; i<count; ++i) {
+      const offset = 16 + i * 16;
+      const first = view.getUint32(offset + 8, true);
+      submissions.push({
+        clock: Number(view.getBigInt64(offset, true)),
+        commands: commands.slice(first, first + view.getUint32(offset + 12, true)),
+      });
+    }
+    let triangles = 0;
+    for(let i=0; i<commands.length;) {
+      const id = Number(commands[i] >> 56n) & 0x3F;
+      if(id >= 0x08 && id <= 0x0F)++triangles;
+      i += rdpCommandSize(id);
+    }
+    return {submissions, triangles, overflow: view.getUint32(8, true)};
+  }
+
+  resetRDPCapture() {
+    this.fn.rsp_rdp_capture_reset();
+  }
+
+  /**
+   * Calls 'handler({kind, data, clock})' as soon as one of the given events happens, e.g. to sync an emulated CPU on a BREAK.
+   * Events are queued for 'drainEvents()' either way, this is only needed if waiting for the end of a run is too late.
+   * @param {((event: {kind: string, data: number, clock: number}) => void)|null} handler
+   * @param {string[]} kinds any of RSP_EVENTS
+   */
+  setEventHandler(handler, kinds = ['break', 'interrupt']) {
+    this.eventHandler = handler;
+    if(handler && !this.eventSlot) {
+      const table = this.fn.__indirect_function_table;
+      this.eventSlot = table.grow(1);
+      table.set(this.eventSlot, wasmEventFunction((kind, data) => this.handleEvent(kind, data)));
+      this.fn.rsp_set_event_callback(this.eventSlot);
+    }
+    let mask = 0;
+    if(handler)for(const kind of kinds)mask |= 1 << RSP_EVENTS.indexOf(kind);
+    this.fn.rsp_events_immediate(mask);
+  }
+
+  /**
+   * Returns and clears the events queued since the last call (BREAK, interrupt line, signal bits).
+   * 'data' is the PC for 'break', 1/0 for a raised/lowered 'interrupt' and the new signal bits for 'signal'.
+   * @returns {{events: Array<{kind: string, data: number, clock: number}>, overflow: number}}
+   */
+  drainEvents() {
+    const view = new DataView(this.fn.memory.buffer, this.fn.rsp_events_ptr());
+    const count = view.getUint32(0, true);
+    const events = [];
+    for(let i=0; i<count; ++i) {
+      const offset = 16 + i * 16;
+      events.push({
+        kind: RSP_EVENTS[view.getUint32(offset + 8, true)],
+        data: view.getUint32(offset + 12, true),
+        clock: Number(view.getBigInt64(offset, true)),
+      });
+    }
+    const overflow = view.getUint32(4, true);
+    this.fn.rsp_events_reset();
+    return {events, overflow};
+  }
+
+  // called from WASM (through the function table slot of setEventHandler()) for the kinds enabled there
+  handleEvent(kind, data) {
+    this.eventHandler?.({kind: RSP_EVENTS[kind], data, clock: this.getCycles()});
+  }
+
+  /**
+   * Flags memory as modified after writing to 'IMEM'/'DMEM' views directly.
+   * Needed before stepping, fork() or select(), other helpers here do this already.
+   */
+  markDirty() {
+    this.fn.rsp_mark_dirty(0xFFFF, 0xFFFF);
+  }
+
+  /**
+   * Forks a context (default: the current one), memory is shared copy-on-write.
+   * @param {number} handle
+   * @returns {number} handle of the new context
+   */
+  fork(handle = this.fn.rsp_context()) {
+    this.#syncDirty();
+    const res = this.fn.rsp_fork(handle);
+    if(res === -1)throw new Error("RSP fork failed, out of contexts or memory pages");
+    return res;
+  }
+
+  /**
+   * Switches to another context, the current one is preserved
+   * @param {number} handle
+   */
+  select(handle) {
+    this.#syncDirty();
+    if(!this.fn.rsp_select(handle))throw new Error("Invalid RSP context: " + handle);
+  }
+
+  /**
+   * Frees a context (must not be the current one)
+   * @param {number} handle
+   */
+  free(handle) {
+    if(!this.fn.rsp_free(handle))throw new Error("Cannot free RSP context: " + handle);
+  }
+
+  /**
+   * Enables 'stepBack()' by taking a checkpoint every 'interval' cycles and on every step()/run() call.
+   * @param {number} interval cycles between checkpoints, 0 disables it
+   */
+  enableTimeline(interval = 10000) {
+    this.timelineInterval = interval >>> 0;
+    this.fn.rsp_timeline_enable(this.timelineInterval);
+  }
+
+  /**
+   * Goes back in time by the given amount of executed steps.
+   * @param {number} count
+   */
+  stepBack(count = 1) {
+    if(!this.fn.rsp_step_back(count))throw new Error("Cannot step back " + count + ", not enough history or a DMA in-between");
+  }
+
+  /**
+   * Steps executed since the timeline was enabled
+   * @returns {number}
+   */
+  getSteps() {
+    return this.fn.rsp_get_steps();
+  }
+
+  /**
+   * Starts recording all changes made from the outside (memory, registers, status) between runs.
+   */
+  startRecording() {
+    this.fn.rsp_record_start();
+  }
+
+  /**
+   * Stops recording and returns the log, which 'replay()' can reproduce the run from.
+   * @returns {Uint8Array}
+   */
+  stopRecording() {
+    const size = this.fn.rsp_record_stop();
+    if(!size)throw new Error("RSP recording not started or log buffer full");
+    return new Uint8Array(this.fn.memory.buffer, this.fn.rsp_record_ptr(), size).slice();
+  }
+
+  /**
+   * Replays a recorded log from a blank state, the RSP ends up where the recording stopped.
+   * @param {Uint8Array} log
+   * @returns {boolean} true if the final state matches the recorded one
+   */
+  replay(log) {
+    if(log.length > this.fn.rsp_record_capacity())throw new Error("RSP log too large");
+    new Uint8Array(this.fn.memory.buffer, this.fn.rsp_record_ptr(), log.length).set(log);
+    this.dirtyDMEM = 0;
+    return !!this.fn.rsp_replay(log.length);
+  }
+
+  #syncDirty() {
+    this.fn.rsp_mark_dirty(0, this.dirtyDMEM);
+    this.dirtyDMEM = 0;
   }
 }
 
+const MEM_SIZE = 0x1000;
+const DMA_LOG_SIZE = 256; // RSP::DMAStats::Capacity
+const RDP_CAPTURE_COMMANDS = 16 + 16 * 1024 * 16; // offset of RSP::RDPCapture::commands
+const SLICE_CYCLES_MIN = 1024;
+const SLICE_CYCLES_MAX = 1 << 30;
+
+const yieldToEventLoop = typeof setImmediate === 'function'
+  ? () => new Promise(resolve => setImmediate(resolve))
+  : (() => {
+    // MessageChannel avoids the clamping browsers apply to nested setTimeout(0)
+    const channel = new MessageChannel();
+    const queue = [];
+    channel.port1.onmessage = () => queue.shift()();
+    return () => new Promise(resolve => {
+      queue.push(resolve);
+      channel.port2.postMessage(0);
+    });
+  })();
+
+function copyToLE(view, data, offset) {
+  const src = ArrayBuffer.isView(data)
+    ? new DataView(data.buffer, data.byteOffset, data.byteLength)
+    : new DataView(data);
+  const size = Math.min(src.byteLength, MEM_SIZE - offset) & ~0b11;
+  for(let i=0; i<size; i += 4) {
+    view.setUint32(offset + i, src.getUint32(i, false), true);
+  }
+  // bitmask of the touched 256-byte pages
+  if(size <= 0)return 0;
+  const pageFirst = offset >> 8;
+  const pageLast = (offset + size - 1) >> 8;
+  return ((1 << (pageLast + 1)) - 1) & ~((1 << pageFirst) - 1);
+}
+
+// size of an RDP command in 64-bit words, triangles grow with their shade/texture/z coefficients
+function rdpCommandSize(id) {
+  if(id >= 0x08 && id <= 0x0F)return 4 + (id & 4 ? 8 : 0) + (id & 2 ? 8 : 0) + (id & 1 ? 2 : 0);
+  if(id === 0x24 || id === 0x25)return 2;
+  return 1;
+}
+
+function copyFromLE(view) {
+  const res = new Uint8Array(MEM_SIZE);
+  const dst = new DataView(res.buffer);
+  for(let i=0; i<MEM_SIZE; i += 4) {
+    dst.setUint32(i, view.getUint32(i, true), false);
+  }
+  return res;
+}
+
 let wasmModule;
 
 async function getWasmModule() {
   const filePath = new URL('rsp.wasm', import.meta.url);
-  if (typeof window === 'undefined') {
+  if (IS_NODE) {
     const {readFile} = await import('fs/promises');
     const wasmBuffer = readFile(filePath);
-    return WebAssembly.instantiate(await wasmBuffer, {});
+    return WebAssembly.compile(await wasmBuffer);
   } else {
     var response = fetch(filePath, {
       credentials: "same-origin"
     });
-    return await WebAssembly.instantiateStreaming(response, {});
+    return await WebAssembly.compileStreaming(response);
   }
 }
 
+async function createRSPFromModule(module) {
+  return new RSP(await WebAssembly.instantiate(module, {}));
+}
+
 /**
  * @returns {Promise<RSP>}
  */
@@ -156,5 +606,417 @@ export async function createRSP() {
   if(!wasmModule) {
     wasmModule = getWasmModule();
   }
-  return new RSP(await wasmModule);
+  return createRSPFromModule(await wasmModule);
+}
+
+// RDRAM range the last job on an RSP may have changed (host data and DMA writes), reset() leaves RDRAM alone
+const jobRDRAMDirty = new WeakMap();
+
+function rdramWrittenRange(job, dma, size) {
+  let start = size, end = 0;
+  const add = (from, to) => {
+    start = Math.min(start, from);
+    end = Math.max(end, to);
+  };
+  if(job.rdram)add(job.rdramAddress ?? 0, (job.rdramAddress ?? 0) + job.rdram.byteLength);
+  if(dma.count > dma.transfers.length)add(0, size); // older transfers fell out of the log
+  for(const t of dma.transfers) {
+    if(t.write)add(t.dramAddress, t.dramAddress + t.rows * (t.length + t.skip));
+  }
+  return end > size ? {start: 0, end: size} : {start, end}; // wrapped around the end
+}
+
+/**
+ * Runs a single pool job on a given RSP instance.
+ * Memory images are big-endian, registers can be indexed by number or name.
+ * Whatever the previous job on this RSP wrote to RDRAM is zeroed first.
+ */
+function runJob(rsp, job) {
+  rsp.reset();
+  const dirty = jobRDRAMDirty.get(rsp);
+  if(dirty && dirty.start < dirty.end)rsp.RDRAM.fill(0, dirty.start, dirty.end);
+  rsp.setFunctional(!!job.functional);
+  if(job.imem)rsp.loadIMEM(job.imem);
+  if(job.dmem)rsp.loadDMEM(job.dmem);
+  if(job.rdram)rsp.loadRDRAM(job.rdram, job.rdramAddress ?? 0);
+  for(const [reg, value] of Object.entries(job.gpr || {})) {
+    rsp.setGPR(isNaN(reg) ? reg : Number(reg), value);
+  }
+  for(const [reg, values] of Object.entries(job.vpr || {})) {
+    rsp.setVPR(isNaN(reg) ? reg : Number(reg), values);
+  }
+  if(job.pc !== undefined)rsp.setPC(job.pc);
+
+  const timeStart = performance.now();
+  const cycles = rsp.run(job.maxCycles ?? 0xFFFF_FFFF);
+  const timeMs = performance.now() - timeStart;
+  const dma = rsp.getDMAStats();
+  jobRDRAMDirty.set(rsp, rdramWrittenRange(job, dma, rsp.RDRAM.length));
+
+  const gpr = new Uint32Array(REGS_SCALAR.length);
+  for(let i=0; i<gpr.length; ++i)gpr[i] = rsp.getGPR(i);
+
+  const vpr = new Uint16Array(REGS_VECTOR.length * 8);
+  for(let i=0; i<REGS_VECTOR.length; ++i)vpr.set(rsp.getVPR(i), i * 8);
+
+  return {
+    dmem: rsp.readDMEM(),
+    gpr, vpr,
+    pc: rsp.getPC(),
+    status: rsp.getStatus(),
+    dma,
+    events: rsp.drainEvents().events,
+    cycles, timeMs,
+  };
+}
+
+async function spawnWorker(module) {
+  const url = new URL(import.meta.url);
+  let worker;
+  if(IS_NODE) {
+    const {Worker} = await import('worker_threads');
+    const nodeWorker = new Worker(url, {workerData: {[POOL_WORKER_PARAM]: true}});
+    worker = {
+      post: (msg, transfer) => nodeWorker.postMessage(msg, transfer),
+      onMessage: (fn) => nodeWorker.on('message', fn),
+      onError: (fn) => nodeWorker.on('error', fn),
+      terminate: () => nodeWorker.terminate(),
+    };
+  } else {
+    url.searchParams.set(POOL_WORKER_PARAM, '1');
+    const webWorker = new Worker(url, {type: 'module'});
+    worker = {
+      post: (msg, transfer) => webWorker.postMessage(msg, transfer),
+      onMessage: (fn) => webWorker.addEventListener('message', e => fn(e.data)),
+      onError: (fn) => webWorker.addEventListener('error', fn),
+      terminate: () => webWorker.terminate(),
+    };
+  }
+  worker.post({type: 'init', module});
+  return worker;
+}
+
+/**
+ * Pool of workers each owning one RSP instance, all sharing one compiled module.
+ * Jobs are queued and handed to the next idle worker.
+ */
+class RSPPool {
+  constructor(workers, module) {
+    this.module = module;
+    this.workers = workers;
+    this.idle = [...workers];
+    this.queue = [];
+    this.pending = new Map();
+    this.nextId = 0;
+    this.closed = false;
+
+    for(const worker of workers)this.#attach(worker);
+  }
+
+  get size() {
+    return this.workers.length;
+  }
+
+  /**
+   * Queues a job, resolves with its final state.
+   * @param {{imem?: ArrayBuffer|ArrayBufferView, dmem?: ArrayBuffer|ArrayBufferView,
+   *          gpr?: Object|Array, vpr?: Object|Array, pc?: number, maxCycles?: number}} job
+   * @param {Transferable[]} transfer buffers to move to the worker instead of copying
+   * @returns {Promise<{dmem: Uint8Array, gpr: Uint32Array, vpr: Uint16Array,
+   *          pc: number, status: number, cycles: number, timeMs: number}>}
+   */
+  run(job, transfer = []) {
+    return new Promise((resolve, reject) => {
+      this.queue.push({id: this.nextId++, job, transfer, resolve, reject});
+      this.#dispatch();
+    });
+  }
+
+  /**
+   * Stops all workers, pending jobs are rejected.
+   */
+  async close() {
+    this.closed = true;
+    for(const entry of [...this.queue, ...this.pending.values()]) {
+      entry.reject(new Error("RSP pool closed"));
+    }
+    this.queue = [];
+    this.pending.clear();
+    await Promise.all(this.workers.map(w => w.terminate()));
+  }
+
+  #dispatch() {
+    while(this.idle.length && this.queue.length) {
+      const worker = this.idle.pop();
+      const entry = this.queue.shift();
+      entry.worker = worker;
+      this.pending.set(entry.id, entry);
+      worker.post({type: 'job', id: entry.id, job: entry.job}, entry.transfer);
+    }
+  }
+
+  #onResult(worker, {id, result, error}) {
+    const entry = this.pending.get(id);
+    this.pending.delete(id);
+    if(this.workers.includes(worker))this.idle.push(worker);
+    if(entry) {
+      if(error)entry.reject(new Error(error));
+      else entry.resolve(result);
+    }
+    this.#dispatch();
+  }
+
+  #attach(worker) {
+    worker.onMessage(msg => this.#onResult(worker, msg));
+    worker.onError(err => this.#onError(worker, err));
+  }
+
+  #onError(worker, err) {
+    if(!this.workers.includes(worker))return;
+    for(const [id, entry] of this.pending) {
+      if(entry.worker === worker) {
+        this.pending.delete(id);
+        entry.reject(err);
+      }
+    }
+
+    // a crashed worker is dropped and replaced, its RSP can't be trusted anymore
+    this.workers = this.workers.filter(w => w !== worker);
+    this.idle = this.idle.filter(w => w !== worker);
+    worker.terminate();
+    if(this.closed)return;
+
+    spawnWorker(this.module).then(replacement => {
+      if(this.closed) {
+        replacement.terminate();
+        return;
+      }
+      this.#attach(replacement);
+      this.workers.push(replacement);
+      this.idle.push(replacement);
+      this.#dispatch();
+    }, spawnErr => {
+      if(this.workers.length)return;
+      for(const entry of this.queue)entry.reject(spawnErr);
+      this.queue = [];
+    });
+  }
+}
+
+/**
+ * Creates a pool of RSP workers (worker_threads in node, Web Workers in browsers).
+ * @param {number} workerCount defaults to the number of logical cores
+ * @returns {Promise<RSPPool>}
+ */
+export async function createRSPPool(workerCount) {
+  if(!workerCount) {
+    if(IS_NODE) {
+      const os = await import('os');
+      workerCount = os.availableParallelism ? os.availableParallelism() : os.cpus().length;
+    } else {
+      workerCount = navigator.hardwareConcurrency || 4;
+    }
+  }
+  if(!wasmModule) {
+    wasmModule = getWasmModule();
+  }
+  const module = await wasmModule;
+  const workers = [];
+  for(let i=0; i<workerCount; ++i) {
+    workers.push(await spawnWorker(module));
+  }
+  return new RSPPool(workers, module);
+}
+
+const RSP_CLOCK = 62_500_000;
+
+// internal rspq commands (see CMD_RSPQ in rsp.cpp) and signals (libdragon's rspq_constants.h)
+const RSPQ_CMD_JUMP = 0x02;
+const RSPQ_CMD_WRITE_STATUS = 0x06;
+const RSPQ_SIG_RDPSYNCFULL = 2;
+const RSPQ_SIG_SYNCPOINT = 3;
+const RSPQ_SIG_BUFDONE = 6;
+const RSPQ_SIG_MORE = 7;
+
+// cycles per rsp.run() in-between checks of the signals, and the default budget of a run (10s in RSP time)
+const RSPQ_SLICE_CYCLES = 4096;
+const RSPQ_MAX_CYCLES = 10 * RSP_CLOCK;
+
+const SP_STATUS_HALTED = 1 << 0;
+const SP_WSTATUS_CLEAR_HALT = 1 << 0;
+const SP_WSTATUS_CLEAR_BROKE = 1 << 2;
+const spStatusSig = sig => 1 << (7 + sig);
+const spWStatusClearSig = sig => 1 << (9 + sig * 2);
+const spWStatusSetSig = sig => 1 << (10 + sig * 2);
+
+/**
+ * Host side of libdragon's rspq: writes commands into two RDRAM buffers the way the CPU does,
+ * chaining them with WRITE_STATUS(BUFDONE) + JUMP, and raises SIG_MORE to wake up the ucode.
+ * SIG_SYNCPOINT and SIG_RDPSYNCFULL are cleared like the CPU's SP and DP interrupt handlers would
+ * (there is no RDP, a SYNC_FULL completes right away), checked every RSPQ_SLICE_CYCLES.
+ * The ucode and its DMEM image (incl. registered overlays) come from the caller, as does the DMEM offset
+ * of 'rspq_dram_addr' since the layout of 'rspq_data' differs between libdragon versions.
+ */
+export class RSPQ {
+  /**
+   * @param {RSP} rsp
+   * @param {{dramAddrOffset: number, bufferAddress?: number, bufferWords?: number}} options
+   */
+  constructor(rsp, {dramAddrOffset, bufferAddress = 0x10_0000, bufferWords = 0x200}) {
+    this.rsp = rsp;
+    this.dramAddrOffset = dramAddrOffset;
+    this.buffers = [bufferAddress, bufferAddress + bufferWords * 4];
+    this.bufferWords = bufferWords;
+    this.RDRAM = new DataView(rsp.RDRAM.buffer, rsp.RDRAM.byteOffset, rsp.RDRAM.byteLength);
+    this.commands = 0;
+    this.cycles = 0;
+  }
+
+  /**
+   * Loads the ucode and lets it run until it waits for input.
+   * @param {{imem: ArrayBuffer|ArrayBufferView, dmem: ArrayBuffer|ArrayBufferView, pc?: number}} ucode big-endian images
+   */
+  boot({imem, dmem, pc = 0}) {
+    const rsp = this.rsp;
+    rsp.reset();
+    rsp.loadIMEM(imem);
+    rsp.loadDMEM(dmem);
+    for(const address of this.buffers) {
+      rsp.RDRAM.fill(0, address, address + this.bufferWords * 4);
+    }
+    const pointer = new Uint8Array(4);
+    new DataView(pointer.buffer).setUint32(0, this.buffers[0], false);
+    rsp.loadDMEM(pointer, this.dramAddrOffset);
+
+    this.index = 0;
+    this.cursor = 0;
+    rsp.setPC(pc);
+    // both buffers start out as done, so the first switch doesn't wait
+    rsp.setStatus(spWStatusSetSig(RSPQ_SIG_BUFDONE) | SP_WSTATUS_CLEAR_HALT | SP_WSTATUS_CLEAR_BROKE);
+    if(!this.#runUntil(() => false))throw new Error("rspq: ucode still busy after boot");
+    this.commands = 0;
+    this.cycles = 0;
+  }
+
+  /**
+   * Queues a command, the first argument shares the first word with the command id (rspq_write).
+   * @param {number} id overlay id << 4 | command index
+   * @param {...number} args
+   */
+  write(id, ...args) {
+    const words = [((id << 24) | ((args[0] ?? 0) & 0xFF_FFFF)) >>> 0, ...args.slice(1)];
+    // each buffer ends with WRITE_STATUS + JUMP
+    if(words.length > this.bufferWords - 2) {
+      throw new RangeError(`rspq: command of ${words.length} words doesn't fit into a buffer of ${this.bufferWords}`);
+    }
+    if(this.cursor + words.length + 2 > this.bufferWords)this.#nextBuffer();
+
+    const base = this.buffers[this.index] + this.cursor * 4;
+    for(let i=0; i<words.length; ++i)this.RDRAM.setUint32(base + i * 4, words[i] >>> 0, false);
+    this.cursor += words.length;
+    this.commands++;
+  }
+
+  /**
+   * Wakes up the ucode to process what was written so far
+   */
+  flush() {
+    this.rsp.setStatus(spWStatusSetSig(RSPQ_SIG_MORE) | SP_WSTATUS_CLEAR_HALT | SP_WSTATUS_CLEAR_BROKE);
+  }
+
+  /**
+   * Flushes and runs until the queue is empty (the ucode halts waiting for more input).
+   * Throughput is measured in RSP time (62.5MHz) over all commands written since the last run(),
+   * including the cycles spent while write() had to wait for a buffer.
+   * 'reason' is 'maxCycles' if the ucode was still busy when the budget ran out.
+   * @param {{maxCycles?: number}} options
+   * @returns {{reason: 'halted'|'maxCycles', commands: number, cycles: number, commandsPerSecond: number, timeMs: number}}
+   */
+  run({maxCycles = RSPQ_MAX_CYCLES} = {}) {
+    const timeStart = performance.now();
+    this.flush();
+    const reason = this.#runUntil(() => false, maxCycles) ? 'halted' : 'maxCycles';
+    const {commands, cycles} = this;
+    this.commands = this.cycles = 0;
+    return {
+      reason, commands, cycles,
+      commandsPerSecond: cycles ? commands * RSP_CLOCK / cycles : 0,
+      timeMs: performance.now() - timeStart,
+    };
+  }
+
+  // runs in slices until 'done()' or the ucode halts, returns false if 'maxCycles' ran out first
+  #runUntil(done, maxCycles = RSPQ_MAX_CYCLES) {
+    const rsp = this.rsp;
+    const syncSignals = spStatusSig(RSPQ_SIG_SYNCPOINT) | spStatusSig(RSPQ_SIG_RDPSYNCFULL);
+    let cycles = 0;
+    for(;;) {
+      const status = rsp.getStatus();
+      if(status & syncSignals) {
+        rsp.setStatus(spWStatusClearSig(RSPQ_SIG_SYNCPOINT) | spWStatusClearSig(RSPQ_SIG_RDPSYNCFULL));
+      }
+      if(done() || status & SP_STATUS_HALTED)return true;
+      if(cycles >= maxCycles)return false;
+
+      const slice = rsp.run(Math.min(RSPQ_SLICE_CYCLES, maxCycles - cycles));
+      cycles += slice;
+      this.cycles += slice;
+    }
+  }
+
+  // same as rspq_next_buffer(): wait for the RSP to be done with the other buffer, then jump over to it
+  #nextBuffer() {
+    const rsp = this.rsp;
+    const bufDone = () => rsp.getStatus() & spStatusSig(RSPQ_SIG_BUFDONE);
+    if(!bufDone()) {
+      this.flush();
+      if(!this.#runUntil(bufDone) || !bufDone()) {
+        throw new Error("rspq: ucode halted or ran out of cycles without finishing the previous buffer");
+      }
+    }
+    rsp.setStatus(spWStatusClearSig(RSPQ_SIG_BUFDONE));
+
+    const prev = this.buffers[this.index] + this.cursor * 4;
+    this.index = 1 - this.index;
+    this.cursor = 0;
+    const next = this.buffers[this.index];
+    rsp.RDRAM.fill(0, next, next + this.bufferWords * 4);
+
+    this.RDRAM.setUint32(prev, ((RSPQ_CMD_WRITE_STATUS << 24) | spWStatusSetSig(RSPQ_SIG_BUFDONE)) >>> 0, false);
+    this.RDRAM.setUint32(prev + 4, ((RSPQ_CMD_JUMP << 24) | next) >>> 0, false);
+    this.flush();
+  }
+}
+
+async function poolWorkerMain(post, onMessage) {
+  let rsp;
+  onMessage(async ({type, id, module, job}) => {
+    if(type === 'init') {
+      rsp = createRSPFromModule(module);
+      return;
+    }
+    try {
+      const result = runJob(await rsp, job);
+      post({id, result}, [result.dmem.buffer, result.gpr.buffer, result.vpr.buffer]);
+    } catch(e) {
+      post({id, error: String(e?.stack || e)});
+    }
+  });
+}
+
+if(IS_NODE) {
+  const {isMainThread, workerData, parentPort} = await import('worker_threads');
+  if(!isMainThread && workerData?.[POOL_WORKER_PARAM]) {
+    poolWorkerMain(
+      (msg, transfer) => parentPort.postMessage(msg, transfer),
+      fn => parentPort.on('message', fn)
+    );
+  }
+} else if(typeof WorkerGlobalScope !== 'undefined'
+  && new URL(import.meta.url).searchParams.has(POOL_WORKER_PARAM)
+) {
+  poolWorkerMain(
+    (msg, transfer) => self.postMessage(msg, transfer),
+    fn => self.addEventListener('message', e => fn(e.data))
+  );
 }
@@ -1,10 +1,15 @@
 #include "main.h"
 #include "rsp/rsp.cpp"
 
+WASM_EXPORTS_BEGIN
+
 void WASM_EXPORT(rsp_init)()
 {
   ares::N64::rsp.load();
-  ares::N64::rsp.reset();
+  ares::N64::rsp.power(false);
+  ares::N64::contexts.reset();
+  ares::N64::timeline.reset();
+  ares::N64::hostEvents.reset();
 }
 
 void WASM_EXPORT(rsp_set_halted)(u32 isHalted)
@@ -12,31 +17,95 @@ void WASM_EXPORT(rsp_set_halted)(u32 isHalted)
   ares::N64::rsp.status.halted = isHalted ? 1 : 0;
 }
 
+void WASM_EXPORT(rsp_set_functional)(u32 enabled)
+{
+  ares::N64::rsp.functional = enabled ? 1 : 0;
+}
+
 void WASM_EXPORT(rsp_step)(u32 steps)
 {
+  ares::N64::recorder.enter();
+  ares::N64::timeline.enter();
   for(int i=0; i<steps; ++i) {
+    ares::N64::timeline.step();
     ares::N64::rsp.exec();
   }
+  ares::N64::rsp.accumulatorFlush();
+  ares::N64::recorder.leave();
+}
+
+/**
+ * Runs until the RSP halts or at least 'cycles' have passed.
+ * Returns the amount of cycles actually executed.
+ */
+u32 WASM_EXPORT(rsp_run)(u32 cycles)
+{
+  auto& rsp = ares::N64::rsp;
+  ares::N64::recorder.enter();
+  ares::N64::timeline.enter();
+  s64 start = rsp.clock;
+  s64 end = start + cycles;
+  if(ares::N64::timeline.active()) {
+    //the timeline has to see every single step
+    while(rsp.clock < end && !rsp.status.halted) {
+      ares::N64::timeline.step();
+      rsp.exec();
+    }
+  } else {
+    rsp.run(end);
+  }
+  rsp.accumulatorFlush();
+  ares::N64::recorder.leave();
+  return rsp.clock - start;
+}
+
+/**
+ * Lets a halted RSP sit idle for up to 'cycles', or until the next scheduled event (e.g. a DMA row) if 'cycles' is 0.
+ * Costs nothing per idle cycle, returns the cycles passed (0 if the RSP isn't halted).
+ */
+u32 WASM_EXPORT(rsp_idle)(u32 cycles)
+{
+  auto& rsp = ares::N64::rsp;
+  if(!rsp.status.halted) return 0;
+  if(!cycles) {
+    if(rsp.scheduler.next == ares::N64::RSP::Scheduler::Never) return 0;
+    cycles = rsp.scheduler.next > rsp.clock ? rsp.scheduler.next - rsp.clock : 1;
+  }
+
+  ares::N64::recorder.enter();
+  ares::N64::timeline.enter();
+  s64 start = rsp.clock;
+  s64 end = start + cycles;
+  if(ares::N64::timeline.active()) {
+    while(rsp.clock < end && rsp.status.halted) {
+      ares::N64::timeline.step();
+      rsp.exec();
+    }
+  } else {
+    rsp.idle(end);
+  }
+  ares::N64::recorder.leave();
+  return rsp.clock - start;
 }
 
-u32 WASM_EXPORT(rsp_ptr_dmem)()
+uptr WASM_EXPORT(rsp_ptr_dmem)()
 {
-  return (u32)ares::N64::rsp.dmem.data;
+  return (uptr)ares::N64::rsp.dmem.data;
 }
 
-u32 WASM_EXPORT(rsp_ptr_imem)()
+uptr WASM_EXPORT(rsp_ptr_imem)()
 {
-  return (u32)ares::N64::rsp.imem.data;
+  return (uptr)ares::N64::rsp.imem.data;
 }
 
-u32 WASM_EXPORT(rsp_ptr_gpr)(u32 reg)
+uptr WASM_EXPORT(rsp_ptr_gpr)(u32 reg)
 {
-  return (u32)ares::N64::rsp.ipu.r;
+  return (uptr)ares::N64::rsp.ipu.r;
 }
 
-u32 WASM_EXPORT(rsp_ptr_vpr)(u32 reg)
+uptr WASM_EXPORT(rsp_ptr_vpr)(u32 reg)
 {
-  return (u32)ares::N64::rsp.vpu.r;
+  return (uptr)ares::N64::rsp.vpu.r;
 }
 
 u32 WASM_EXPORT(rsp_get_cycles)()
@@ -44,3 +113,252 @@ u32 WASM_EXPORT(rsp_get_cycles)()
   return ares::N64::rsp.clock;
 }
 
+/**
+ * Creates a new context from an existing one, sharing memory copy-on-write.
+ * Returns the new handle, or ~0 if out of contexts/pages.
+ */
+u32 WASM_EXPORT(rsp_fork)(u32 handle)
+{
+  return ares::N64::contexts.fork(handle);
+}
+
+/**
+ * Switches the emulated RSP to another context, the current one is kept as-is.
+ */
+u32 WASM_EXPORT(rsp_select)(u32 handle)
+{
+  return ares::N64::contexts.select(handle);
+}
+
+u32 WASM_EXPORT(rsp_free)(u32 handle)
+{
+  return ares::N64::contexts.free(handle);
+}
+
+u32 WASM_EXPORT(rsp_context)()
+{
+  return ares::N64::contexts.current;
+}
+
+/**
+ * Flags 256-byte pages as modified by the host (writes through the memory views bypass tracking).
+ */
+void WASM_EXPORT(rsp_mark_dirty)(u32 imemPages, u32 dmemPages)
+{
+  ares::N64::rsp.imem.dirty |= imemPages;
+  ares::N64::rsp.dmem.dirty |= dmemPages;
+  ares::N64::rsp.imem.touch(imemPages);
+  ares::N64::rsp.dmem.touch(dmemPages);
+}
+
+u32 WASM_EXPORT(rsp_get_status)()
+{
+  return ares::N64::rsp.ioRead(4 << 2, ares::N64::rsp);
+}
+
+/**
+ * Writes SP_STATUS like the CPU would (set/clear bit pairs).
+ */
+void WASM_EXPORT(rsp_set_status)(u32 value)
+{
+  ares::N64::rsp.ioWrite(4 << 2, value, ares::N64::rsp);
+}
+
+/**
+ * RDRAM the DMA engine reads from and writes to, big-endian bytes, see 'rsp_rdram_size'.
+ * Left untouched by resets, contexts and checkpoints.
+ */
+uptr WASM_EXPORT(rsp_ptr_rdram)()
+{
+  return (uptr)ares::N64::rdram.data;
+}
+
+u32 WASM_EXPORT(rsp_rdram_size)()
+{
+  return ares::N64::RDRAM::Size;
+}
+
+/**
+ * DMA profiling: time spent polling SP_DMA_BUSY/SP_DMA_FULL and a log of the last transfers (RSP::DMAStats).
+ */
+uptr WASM_EXPORT(rsp_dma_stats_ptr)()
+{
+  return (uptr)&ares::N64::rsp.dmaStats;
+}
+
+void WASM_EXPORT(rsp_dma_stats_reset)()
+{
+  ares::N64::rsp.dmaStats.reset();
+}
+
+/**
+ * RDP command words submitted via DPC_START/DPC_END, with the cycle of each submission (RSP::RDPCapture).
+ * Once full, further submissions are dropped and counted, the host drains it with 'rsp_rdp_capture_reset'.
+ */
+uptr WASM_EXPORT(rsp_rdp_capture_ptr)()
+{
+  return (uptr)&ares::N64::rsp.rdpCapture;
+}
+
+void WASM_EXPORT(rsp_rdp_capture_reset)()
+{
+  ares::N64::rsp.rdpCapture.reset();
+}
+
+/**
+ * Queue of BREAK, interrupt and signal events (HostEvents), drained by the host with 'rsp_events_reset'.
+ */
+uptr WASM_EXPORT(rsp_events_ptr)()
+{
+  return (uptr)&ares::N64::hostEvents;
+}
+
+void WASM_EXPORT(rsp_events_reset)()
+{
+  ares::N64::hostEvents.reset();
+}
+
+/**
+ * Event kinds (bitmask) that are reported right away through the event callback, on top of being queued.
+ */
+void WASM_EXPORT(rsp_events_immediate)(u32 mask)
+{
+  ares::N64::hostEvents.immediate = mask;
+}
+
+/**
+ * The function called for immediate events, 'void (u32 kind, u32 data)', 0 to remove it.
+ * In WASM this is an index into the exported '__indirect_function_table', no import is needed.
+ */
+void WASM_EXPORT(rsp_set_event_callback)(uptr callback)
+{
+  ares::N64::hostEvents.callback = (ares::N64::HostEvents::Callback)callback;
+}
+
+
+/**
+ * Starts logging everything the host changes in-between runs (memory, registers, status).
+ * The log lives in the buffer returned by 'rsp_record_ptr'.
+ */
+void WASM_EXPORT(rsp_record_start)()
+{
+  ares::N64::recorder.start();
+}
+
+/**
+ * Ends recording, returns the size of the log or 0 if the buffer overflowed.
+ */
+u32 WASM_EXPORT(rsp_record_stop)()
+{
+  return ares::N64::recorder.stop();
+}
+
+uptr WASM_EXPORT(rsp_record_ptr)()
+{
+  return (uptr)ares::N64::recorder.data;
+}
+
+u32 WASM_EXPORT(rsp_record_capacity)()
+{
+  return ares::N64::Recorder::Capacity;
+}
+
+/**
+ * Replays a log previously placed at 'rsp_record_ptr', starting from a blank RSP.
+ * Returns 1 if the final state matches the recorded one.
+ */
+u32 WASM_EXPORT(rsp_replay)(u32 size)
+{
+  bool result = ares::N64::recorder.replay(size);
+  ares::N64::rsp.accumulatorFlush();
+  return result;
+}
+
+/**
+ * Enables reverse stepping, with a checkpoint every 'interval' cycles (0 disables it).
+ * Checkpoints are forked contexts and count against the context limit.
+ */
+void WASM_EXPORT(rsp_timeline_enable)(u32 interval)
+{
+  ares::N64::timeline.enable(interval);
+}
+
+/**
+ * Goes back 'count' executed steps, returns 0 if that is further back than the oldest checkpoint,
+ * or if getting there would re-execute a DMA transfer (RDRAM isn't checkpointed).
+ */
+u32 WASM_EXPORT(rsp_step_back)(u32 count)
+{
+  bool result = ares::N64::timeline.stepBack(count);
+  ares::N64::rsp.accumulatorFlush();
+  return result;
+}
+
+u32 WASM_EXPORT(rsp_get_steps)()
+{
+  return ares::N64::timeline.steps;
+}
+
+/**
+ * Which VPU kernels this build uses: 0 = scalar, 1 = SSE4.1.
+ * This is not a CPU check, an SSE4.1/AVX2 library may run those instructions anywhere (including here),
+ * so hosts have to check the CPU before loading one.
+ */
+u32 WASM_EXPORT(rsp_vpu_path)()
+{
+  return ares::N64::Accuracy::RSP::SIMD ? 1 : 0;
+}
+
+#if defined(RSP_VPU_CROSSCHECK)
+/**
+ * Runs 'count' random VU instructions through both VPU implementations (clobbers VPU state).
+ * Returns how many of them diverged, details of the first one are at 'rsp_crosscheck_ptr'.
+ */
+u32 WASM_EXPORT(rsp_crosscheck_random)(u32 count, u32 seed)
+{
+  return ares::N64::rsp.crossCheckRandom(count, seed);
+}
+
+/**
+ * Runs 'count' random sequences of 'length' VU instructions through both VPU implementations, keeping the
+ * accumulator wide between them (clobbers VPU state). Returns how many sequences diverged.
+ */
+u32 WASM_EXPORT(rsp_crosscheck_sequence)(u32 count, u32 length, u32 seed)
+{
+  return ares::N64::rsp.crossCheckSequence(count, length, seed);
+}
+
+/**
+ * Runs 'count' random LTV/STV/SWV through the interpreter and through the per-byte reference loops
+ * (clobbers VPU state and DMEM). Returns how many of them differ.
+ */
+u32 WASM_EXPORT(rsp_crosscheck_transpose)(u32 count, u32 seed)
+{
+  return ares::N64::rsp.crossCheckTranspose(count, seed);
+}
+
+/**
+ * Compares VRCP/VRSQ against the tables power() used to build: all single-precision
+ * inputs plus 'samples' random double-precision ones. Returns the number of mismatches.
+ */
+u32 WASM_EXPORT(rsp_crosscheck_divide)(u32 samples, u32 seed)
+{
+  return ares::N64::rsp.crossCheckDivide(samples, seed);
+}
+
+/**
+ * Runs 'count' steps of a random instruction stream through the pipeline hazard model and through
+ * the stage-by-stage model it replaced. Returns the number of steps where their clocks differ.
+ */
+u32 WASM_EXPORT(rsp_crosscheck_pipeline)(u32 count, u32 seed)
+{
+  return ares::N64::rsp.crossCheckPipeline(count, seed);
+}
+
+uptr WASM_EXPORT(rsp_crosscheck_ptr)()
+{
+  return (uptr)&ares::N64::rsp.crossCheck;
+}
+#endif
+
+WASM_EXPORTS_END
@@ -18,6 +18,7 @@ typedef signed char s8;
 typedef unsigned short u16;
 typedef signed short s16;
 typedef bool bool32;
+typedef __UINTPTR_TYPE__ uptr; // 32-bit in WASM, native builds need the full width
 
 typedef u32 uint32_t;
 typedef s32 int32_t;
@@ -32,3 +33,12 @@ typedef s8 int8_t;
 #define WASM_IMPORT_NAMED(name) __attribute__((visibility("default"), import_name(#name)))
 #define WASM_EXPORT_NAMED(name) __attribute__((visibility("default"), export_name(#name)))
 
+// native hosts look the exports up with dlsym(), so they need C linkage there
+#if defined(__wasm__)
+  #define WASM_EXPORTS_BEGIN
+  #define WASM_EXPORTS_END
+#else
+  #define WASM_EXPORTS_BEGIN extern "C" {
+  #define WASM_EXPORTS_END }
+#endif
+
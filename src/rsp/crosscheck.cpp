@@ -0,0 +1,421 @@
+#if defined(RSP_VPU_CROSSCHECK)
+
+//compares everything the VU instructions write, both states need a flushed accumulator
+static auto crossCheckMatch(const RSP::VU& a, const RSP::VU& b) -> bool {
+  auto same = [](RSP::cr128& a, RSP::cr128& b) {
+    return a.u128.lo == b.u128.lo && a.u128.hi == b.u128.hi;
+  };
+  auto sameFlags = [](const RSP::r8& a, const RSP::r8& b) {
+    return a.bits == b.bits;
+  };
+
+  bool match = a.divin == b.divin && a.divout == b.divout && a.divdp == b.divdp
+    && same(a.acch, b.acch) && same(a.accm, b.accm) && same(a.accl, b.accl)
+    && sameFlags(a.vcoh, b.vcoh) && sameFlags(a.vcol, b.vcol)
+    && sameFlags(a.vcch, b.vcch) && sameFlags(a.vccl, b.vccl) && sameFlags(a.vce, b.vce);
+  for(u32 n : range(32)) match = match && same(a.r[n], b.r[n]);
+  return match;
+}
+
+//runs the instruction through the scalar and the SSE implementation, starting from the same state.
+//execution continues with the scalar result, the first divergence is kept for inspection.
+auto RSP::crossCheckVU() -> void {
+  accumulatorFlush();
+  VU input = vpu;
+  crossCheck.active = 1;
+  Accuracy::RSP::simdPass = false;
+  interpreterVU();
+  accumulatorFlush();
+  VU sisd = vpu;
+
+  vpu = input;
+  Accuracy::RSP::simdPass = true;
+  interpreterVU();
+  Accuracy::RSP::simdPass = false;
+  crossCheck.active = 0;
+  crossCheck.checked++;
+
+  if(!crossCheckMatch(vpu, sisd) && !crossCheck.diverged++) {
+    crossCheck.first.instruction = pipeline.instruction;
+    crossCheck.first.position = 0;
+    crossCheck.first.input = input;
+    crossCheck.first.sisd = sisd;
+    crossCheck.first.simd = vpu;
+  }
+  vpu = sisd;
+}
+
+//xorshift, each check seeds its own
+struct CrossCheckRandom {
+  u64 state;
+  CrossCheckRandom(u32 seed) : state(seed | 1ull << 32) {}
+  auto operator()() -> u64 {
+    state ^= state << 13;
+    state ^= state >>  7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+//random register, accumulator and flag contents for a flushed VPU state
+static auto crossCheckRandomize(RSP::VU& vpu, CrossCheckRandom& next) -> void {
+  //values at the saturation and sign boundaries hit most of the edge cases
+  static constexpr u16 edges[] = {0x0000, 0x0001, 0x7fff, 0x8000, 0x8001, 0xffff};
+
+  auto randomize = [&](RSP::r128& r) {
+    for(u32 n : range(8)) {
+      u64 value = next();
+      r.u16(n) = value >> 8 & 3 ? u16(value >> 16) : edges[(value >> 32) % 6];
+    }
+  };
+
+  for(auto& r : vpu.r) randomize(r);
+  randomize(vpu.acch);
+  randomize(vpu.accm);
+  randomize(vpu.accl);
+  vpu.vcoh.bits = next();
+  vpu.vcol.bits = next();
+  vpu.vcch.bits = next();
+  vpu.vccl.bits = next();
+  vpu.vce.bits  = next();
+  vpu.divin  = next();
+  vpu.divout = next();
+  vpu.divdp  = next() & 1;
+}
+
+//feeds random computational VU instructions with random register contents through crossCheckVU().
+//clobbers the VPU state, returns the number of new divergences.
+auto RSP::crossCheckRandom(u32 count, u32 seed) -> u32 {
+  CrossCheckRandom next(seed);
+  u32 diverged = crossCheck.diverged;
+  for(u32 _ : range(count)) {
+    crossCheckRandomize(vpu, next);
+    //COP2 with bit 25 set: computational op with random element, registers and function
+    pipeline.instruction = 0x4a00'0000 | next() & 0x01ff'ffff;
+    crossCheckVU();
+  }
+  return crossCheck.diverged - diverged;
+}
+
+//crossCheckVU() flushes the accumulator around every instruction, so it never sees the wide accumulator
+//carried from one instruction to the next. this runs random sequences of 'length' instructions, mostly
+//from the multiply-accumulate group on four registers, through both implementations without flushing
+//in between. they are compared after every step on flushed copies, the first divergence records its
+//position in the sequence. clobbers the VPU state, returns the number of diverging sequences.
+auto RSP::crossCheckSequence(u32 count, u32 length, u32 seed) -> u32 {
+  //VMULF..VMADH, minus VRNDP/VMULQ/VRNDN/VMACQ: the ops that keep the accumulator wide
+  static constexpr u8 accumulating[] = {0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0c, 0x0d, 0x0e, 0x0f};
+
+  auto flushed = [&](const VU& state) -> VU {
+    vpu = state;
+    accumulatorFlush();
+    return vpu;
+  };
+
+  CrossCheckRandom next(seed);
+  u32 diverged = crossCheck.diverged;
+  crossCheck.active = 1;
+  for(u32 _ : range(count)) {
+    crossCheckRandomize(vpu, next);
+    VU sisd = vpu;
+    VU simd = vpu;
+    for(u32 position : range(length)) {
+      u64 value = next();
+      u32 function = value & 3 ? accumulating[(value >> 2) % 12] : value >> 8 & 0x3f;
+      u32 registers = (value >> 16 & 3) << 6 | (value >> 18 & 3) << 11 | (value >> 20 & 3) << 16;
+      pipeline.instruction = 0x4a00'0000 | (value >> 24 & 15) << 21 | registers | function;
+
+      VU input = sisd;
+      vpu = sisd;
+      Accuracy::RSP::simdPass = false;
+      interpreterVU();
+      sisd = vpu;
+      vpu = simd;
+      Accuracy::RSP::simdPass = true;
+      interpreterVU();
+      simd = vpu;
+      Accuracy::RSP::simdPass = false;
+      crossCheck.checked++;
+
+      VU sisdFlushed = flushed(sisd);
+      VU simdFlushed = flushed(simd);
+      if(crossCheckMatch(sisdFlushed, simdFlushed)) continue;
+      if(!crossCheck.diverged++) {
+        crossCheck.first.instruction = pipeline.instruction;
+        crossCheck.first.position = position;
+        crossCheck.first.input = flushed(input);
+        crossCheck.first.sisd = sisdFlushed;
+        crossCheck.first.simd = simdFlushed;
+      }
+      break;
+    }
+    vpu = flushed(sisd);
+  }
+  crossCheck.active = 0;
+  return crossCheck.diverged - diverged;
+}
+
+//runs random LTV, STV and SWV through the interpreter and through the per-byte loops they replaced,
+//with random registers, elements and address alignments. clobbers the VPU state and DMEM.
+//returns the number of mismatches.
+auto RSP::crossCheckTranspose(u32 count, u32 seed) -> u32 {
+  CrossCheckRandom next(seed);
+
+  auto referenceLTV = [&](u8 e, u8 vt, u32 address) {
+    auto begin = address & ~7;
+    address = begin + ((e + (address & 8)) & 15);
+    auto vtbase = vt & ~7;
+    auto vtoff = e >> 1;
+    for(u32 i : range(8)) {
+      vpu.r[vtbase + vtoff].byte(i * 2 + 0) = dmem.read<Byte>(address++);
+      if(address == begin + 16) address = begin;
+      vpu.r[vtbase + vtoff].byte(i * 2 + 1) = dmem.read<Byte>(address++);
+      if(address == begin + 16) address = begin;
+      vtoff = vtoff + 1 & 7;
+    }
+  };
+  auto referenceSTV = [&](u8 e, u8 vt, u32 address) {
+    auto start = vt & ~7;
+    auto element = 16 - (e & ~1);
+    auto base = (address & 7) - (e & ~1);
+    address &= ~7;
+    for(u32 offset = start; offset < start + 8; offset++) {
+      dmem.write<Byte>(address + (base++ & 15), vpu.r[offset].byte(element++ & 15));
+      dmem.write<Byte>(address + (base++ & 15), vpu.r[offset].byte(element++ & 15));
+    }
+  };
+  auto referenceSWV = [&](u8 e, u8 vt, u32 address) {
+    auto base = address & 7;
+    address &= ~7;
+    for(u32 offset = e; offset < e + 16; offset++) {
+      dmem.write<Byte>(address + (base++ & 15), vpu.r[vt].byte(offset & 15));
+    }
+  };
+
+  u32 mismatches = 0;
+  for(u32 iteration = 0; iteration < count; iteration++) {
+    u32 kind = next() % 3;  //LTV, STV, SWV
+    u8  e    = next() & 15;
+    u8  vt   = next() & 31;
+    u8  rs   = 1 + next() % 31;
+    u8  imm  = next() & 0x7f;
+    ipu.r[rs].u32 = next();
+    u32 address = ipu.r[rs].u32 + i7(imm) * 16;
+    u32 begin = address & ~7;
+
+    for(auto& r : vpu.r) r.u128.hi = next(), r.u128.lo = next();
+    for(u32 n : range(16)) dmem.write<Byte>(begin + n, next());
+    VU input = vpu;
+    u8 window[16];
+    for(u32 n : range(16)) window[n] = dmem.read<Byte>(begin + n);
+
+    if(kind == 0) referenceLTV(e, vt, address);
+    if(kind == 1) referenceSTV(e, vt, address);
+    if(kind == 2) referenceSWV(e, vt, address);
+    VU expected = vpu;
+    u8 expectedWindow[16];
+    for(u32 n : range(16)) expectedWindow[n] = dmem.read<Byte>(begin + n);
+
+    vpu = input;
+    for(u32 n : range(16)) dmem.write<Byte>(begin + n, window[n]);
+    pipeline.instruction = (kind ? 0x3a : 0x32) << 26 | rs << 21 | vt << 16 | (kind == 2 ? 0x0a : 0x0b) << 11 | e << 7 | imm;
+    if(kind == 0) interpreterLWC2();
+    if(kind != 0) interpreterSWC2();
+
+    bool match = true;
+    for(u32 n : range(32)) match = match && vpu.r[n].u128.hi == expected.r[n].u128.hi && vpu.r[n].u128.lo == expected.r[n].u128.lo;
+    for(u32 n : range(16)) match = match && dmem.read<Byte>(begin + n) == expectedWindow[n];
+    mismatches += !match;
+  }
+  return mismatches;
+}
+
+//the VRCP/VRSQ tables as power() used to build them and the lookup that read them,
+//kept as the reference for the compile-time tables.
+struct DivideReference {
+  u16 reciprocals[512];
+  u16 inverseSquareRoots[512];
+
+  DivideReference() {
+    reciprocals[0] = u16(~0);
+    for(u16 index : range(1, 512)) {
+      u64 a = index + 512;
+      u64 b = (u64(1) << 34) / a;
+      reciprocals[index] = u16(b + 1 >> 8);
+    }
+
+    for(u16 index : range(0, 512)) {
+      u64 a = index + 512 >> (index % 2 == 1);
+      u64 b = 1 << 17;
+      //find the largest b where b < 1.0 / sqrt(a)
+      while(a * (b + 1) * (b + 1) < (u64(1) << 44)) b++;
+      inverseSquareRoots[index] = u16(b >> 1);
+    }
+  }
+
+  template<bool SQ>
+  auto lookup(s32 input) const -> s32 {
+    s32 result = 0;
+    s32 mask = input >> 31;
+    s32 data = input ^ mask;
+    if(input > -32768) data -= mask;
+    if(data == 0) {
+      result = 0x7fff'ffff;
+    } else if(input == -32768) {
+      result = 0xffff'0000;
+    } else {
+      u32 shift = countLeadingZeros(data);
+      u32 index = (u64(data) << shift & 0x7fc0'0000) >> 22;
+      if constexpr(!SQ) {
+        result = reciprocals[index];
+        result = (0x10000 | result) << 14;
+        result = result >> 31 - shift ^ mask;
+      } else {
+        result = inverseSquareRoots[index & 0x1fe | shift & 1];
+        result = (0x10000 | result) << 14;
+        result = result >> (31 - shift >> 1) ^ mask;
+      }
+    }
+    return result;
+  }
+};
+
+//compares the compile-time tables and divideLookup() against DivideReference: every table entry,
+//every single-precision input, the edge values and 'samples' random double-precision inputs.
+//returns the number of mismatches.
+auto RSP::crossCheckDivide(u32 samples, u32 seed) -> u32 {
+  static constexpr s32 edges[] = {
+    0, 1, -1, 0x7fff, -0x8000, 0x8000, -0x8001, 0xffff, 0x10000, -0x10000, 0x7fff'ffff, s32(0x8000'0000),
+  };
+
+  DivideReference reference;
+  u32 mismatches = 0;
+  for(u32 index : range(512)) {
+    mismatches += divideTables.reciprocals[index] != reference.reciprocals[index];
+    mismatches += divideTables.inverseSquareRoots[index] != reference.inverseSquareRoots[index];
+  }
+
+  auto check = [&](s32 input) {
+    mismatches += divideLookup<false>(input) != reference.lookup<false>(input);
+    mismatches += divideLookup<true>(input) != reference.lookup<true>(input);
+  };
+  for(u32 n : range(0x10000)) check(s16(n));
+  for(s32 input : edges) check(input);
+  CrossCheckRandom next(seed);
+  for(u32 sample = 0; sample < samples; sample++) check(s32(next()));
+  return mismatches;
+}
+
+//the stage-by-stage hazard model Pipeline::History replaced, kept as its reference
+struct PipelineReference {
+  u32 clocks = 0;
+  u1 singleIssue = 0;
+
+  struct Stage {
+    u1 load;
+    u32 rWrite;
+    u32 vWrite;
+  } previous[3] = {};
+
+  struct : Stage {
+    u1 store;
+    u1 branch;
+    u32 rRead;
+    u32 vRead;
+  } current = {};
+
+  auto end() -> void {
+    readGPR(current.rRead);
+    readVR(current.vRead);
+    if(current.store) store();
+    singleIssue = current.branch;
+
+    previous[2] = previous[1];
+    previous[1] = previous[0];
+    previous[0] = current;
+    current = {};
+    clocks += 3;
+  }
+
+  auto stall() -> void {
+    previous[2] = previous[1];
+    previous[1] = previous[0];
+    previous[0] = {};
+    clocks += 3;
+  }
+
+  auto issue(const RSP::OpInfo& op) -> void {
+    current.rRead |= op.r.use;
+    if(!op.bypass()) current.rWrite |= op.r.def & ~1;
+    current.vRead |= op.v.use;
+    current.vWrite |= op.v.def;
+    current.load |= op.load();
+    current.store |= op.store();
+    current.branch |= op.branch();
+  }
+
+  auto readGPR(u32 mask) -> void {
+    if(mask & previous[0].rWrite) {
+      stall(), stall();
+    } else if(mask & previous[1].rWrite) {
+      stall();
+    }
+  }
+
+  auto readVR(u32 mask) -> void {
+    if(mask & previous[0].vWrite) {
+      stall(), stall(), stall();
+    } else if(mask & previous[1].vWrite) {
+      stall(), stall();
+    } else if(mask & previous[2].vWrite) {
+      stall();
+    }
+  }
+
+  auto store() -> void {
+    while(previous[1].load) {
+      stall();
+    }
+  }
+};
+
+//drives Pipeline and PipelineReference with the same random instruction stream: single and paired issue
+//as in instruction(), plus stalls from outside. register fields are often narrowed to a few registers,
+//so hazards are frequent. returns the number of steps after which the clocks or single issue differ.
+auto RSP::crossCheckPipeline(u32 count, u32 seed) -> u32 {
+  CrossCheckRandom next(seed);
+  auto instruction = [&] {
+    u64 value = next();
+    u32 word = value;
+    if(value >> 32 & 1) word &= ~(0x1c << 21 | 0x1c << 16 | 0x1c << 11 | 0x1c << 6);
+    return word;
+  };
+
+  Pipeline tested = {};
+  PipelineReference reference;
+  u32 mismatches = 0;
+  for(u32 step = 0; step < count; step++) {
+    u64 value = next();
+    if(value % 8 == 0) {
+      tested.stall();
+      reference.stall();
+    } else {
+      OpInfo op0 = decoderEXECUTE(instruction());
+      tested.issue(op0);
+      reference.issue(op0);
+      if(!tested.singleIssue && !op0.branch()) {
+        OpInfo op1 = decoderEXECUTE(instruction());
+        if(canDualIssue(op0, op1)) {
+          tested.issue(op1);
+          reference.issue(op1);
+        }
+      }
+      tested.end();
+      reference.end();
+    }
+    mismatches += tested.clocks != reference.clocks || tested.singleIssue != reference.singleIssue;
+  }
+  return mismatches;
+}
+
+#endif
@@ -1,14 +1,27 @@
+auto RDRAM::read(u32 address) const -> u64 {
+  u64 data;
+  __builtin_memcpy(&data, &this->data[address & Size - 8], 8);
+  return __builtin_bswap64(data);
+}
+
+auto RDRAM::write(u32 address, u64 data) -> void {
+  data = __builtin_bswap64(data);
+  __builtin_memcpy(&this->data[address & Size - 8], &data, 8);
+}
+
 auto RSP::dmaQueue(u32 clocks, Thread& thread) -> void {
-  dma.clock = (Thread::clock - thread.clock) - clocks;
+  scheduler.schedule(Scheduler::DMA, thread.clock + clocks);
 }
 
-auto RSP::dmaStep(u32 clocks) -> void {
-  if(dma.busy.any()) {
-    dma.clock += clocks;
-    if(dma.clock >= 0) {
-      dmaTransferStep();
-    }
-  }
+//a spin loop shows up as repeated polls from the same instruction: the time between two of them
+//counts as waiting if the earlier one still saw the DMA pending.
+auto RSP::dmaPoll(u32 kind, u1 pending) -> void {
+  if(muted) return;
+  auto& poll = dmaStats.polls[kind];
+  if(poll.pending && poll.pc == ipu.pc) dmaStats.wait[kind] += Thread::clock - poll.clock;
+  poll.pc = ipu.pc;
+  poll.clock = Thread::clock;
+  poll.pending = pending;
 }
 
 auto RSP::dmaTransferStart(Thread& thread) -> void {
@@ -18,31 +31,45 @@ auto RSP::dmaTransferStart(Thread& thread) -> void {
     dma.busy    = dma.full;
     dma.full    = {0,0};
     dmaQueue((dma.current.length+8) / 8 * 3, thread);
+    if(muted) return;
+
+    auto& transfer = dmaStats.log[dmaStats.count++ % DMAStats::Capacity];
+    transfer.queued = dmaStats.queued;
+    transfer.start = thread.clock;
+    transfer.end = 0;
+    transfer.dramAddress = dma.current.dramAddress;
+    transfer.pbusAddress = dma.current.pbusRegion << 12 | dma.current.pbusAddress;
+    transfer.length = dma.current.length + 8;
+    transfer.rows = dma.current.count + 1;
+    transfer.skip = dma.current.skip;
+    transfer.write = dma.busy.write;
   }
 }
 
+//runs once a row has had its time on the bus: the whole row lands at once, then the next one is queued.
 auto RSP::dmaTransferStep() -> void {
-  // @TODO: DMA
-  /*
-  auto& region = !dma.current.pbusRegion ? dmem : imem;
+  Memory::Writable& region = !dma.current.pbusRegion ? dmem : imem;
+  u32 count = (dma.current.length + 8) / 8;
+  timeline.transfer();
 
   if(dma.busy.read) {
-    for(u32 i = 0; i <= dma.current.length; i += 8) {
-        u64 data = rdram.ram.read<Dual>(dma.current.dramAddress, nullptr);
-        region.write<Dual>(dma.current.pbusAddress, data);
-        if (system.homebrewMode) {
-          rsp.debugger.dmaReadWord(dma.current.dramAddress, dma.current.pbusRegion, dma.current.pbusAddress);
-        }
-        dma.current.dramAddress += 8;
-        dma.current.pbusAddress += 8;
+    u64 row[4096 / 8];
+    if(!recorder.feed(row, count)) {
+      for(u32 n : range(count)) row[n] = rdram.read(dma.current.dramAddress + n * 8);
+      recorder.log(row, count);
+    }
+    for(u32 n : range(count)) {
+      region.write<Dual>(dma.current.pbusAddress, row[n]);
+      dma.current.dramAddress += 8;
+      dma.current.pbusAddress += 8;
     }
   }
   if(dma.busy.write) {
-    for(u32 i = 0; i <= dma.current.length; i += 8) {
-        u64 data = region.read<Dual>(dma.current.pbusAddress);
-        rdram.ram.write<Dual>(dma.current.dramAddress, data, "RSP DMA");
-        dma.current.dramAddress += 8;
-        dma.current.pbusAddress += 8;
+    for(u32 n = 0; n < count; n++) {
+      u64 data = region.read<Dual>(dma.current.pbusAddress);
+      rdram.write(dma.current.dramAddress, data);
+      dma.current.dramAddress += 8;
+      dma.current.pbusAddress += 8;
     }
   }
 
@@ -53,7 +80,14 @@ auto RSP::dmaTransferStep() -> void {
   } else {
     dma.busy = {0,0};
     dma.current.length = 0xFF8;
+    if(dmaStats.count && !muted) dmaStats.log[(dmaStats.count - 1) % DMAStats::Capacity].end = Thread::clock;
     dmaTransferStart(*this);
   }
-  */
+}
+
+auto RSP::DMAStats::reset() -> void {
+  wait[Busy] = wait[Full] = 0;
+  count = 0;
+  queued = 0;
+  for(auto& poll : polls) poll = {};
 }
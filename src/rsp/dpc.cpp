@@ -0,0 +1,95 @@
+auto RSP::DPC::readWord(u32 address, Thread& thread) -> u32 {
+  address = (address & 0x1f) >> 2;
+  n32 data;
+
+  if(address == 0) {
+    //DPC_START
+    data.bit(0,23) = command.start;
+  }
+
+  if(address == 1) {
+    //DPC_END
+    data.bit(0,23) = command.end;
+  }
+
+  if(address == 2) {
+    //DPC_CURRENT
+    data.bit(0,23) = command.current;
+  }
+
+  if(address == 3) {
+    //DPC_STATUS
+    data.bit( 0) = command.source;
+    data.bit( 1) = command.freeze;
+    data.bit( 2) = command.flush;
+    data.bit( 7) = 1;  //buffer ready, the RDP is never busy
+    data.bit( 9) = command.endValid;
+    data.bit(10) = command.startValid;
+  }
+
+  //DPC_CLOCK, DPC_BUSY, DPC_PIPE_BUSY, DPC_TMEM_BUSY: no RDP, the counters stay at zero
+  return data;
+}
+
+auto RSP::DPC::writeWord(u32 address, u32 data_, Thread& thread) -> void {
+  address = (address & 0x1f) >> 2;
+  n32 data = data_;
+
+  if(address == 0) {
+    //DPC_START
+    if(!command.startValid) command.start = data.bit(0,23) & ~7;
+    command.startValid = 1;
+  }
+
+  if(address == 1) {
+    //DPC_END
+    command.end = data.bit(0,23) & ~7;
+    command.endValid = 1;
+    if(command.startValid) {
+      command.current = command.start;
+      command.startValid = 0;
+    }
+    if(!command.freeze) submit(thread);
+  }
+
+  if(address == 3) {
+    //DPC_STATUS
+    if(data.bit(0)) command.source = 0;
+    if(data.bit(1)) command.source = 1;
+    if(data.bit(3)) command.freeze = 1;
+    if(data.bit(2)) {
+      command.freeze = 0;
+      if(command.endValid) submit(thread);
+    }
+    if(data.bit(4)) command.flush = 0;
+    if(data.bit(5)) command.flush = 1;
+  }
+
+  //DPC_CURRENT and the counters are read-only
+}
+
+auto RSP::DPC::submit(Thread& thread) -> void {
+  command.endValid = 0;
+  if(command.end <= command.current) return;
+
+  auto& capture = self.rdpCapture;
+  u32 count = (command.end - command.current) / 8;
+  if(self.muted) {
+    //re-executed, captured when it ran the first time
+  } else if(capture.submissionCount == RDPCapture::Submissions || capture.size + count > RDPCapture::Capacity) {
+    capture.overflow++;
+  } else {
+    capture.submissions[capture.submissionCount++] = {thread.clock, capture.size, count};
+    for(u32 n : range(count)) {
+      u32 address = command.current + n * 8;
+      capture.commands[capture.size++] = command.source ? self.dmem.read<Dual>(address & 0xff8) : rdram.read(address);
+    }
+  }
+  command.current = command.end;
+}
+
+auto RSP::RDPCapture::reset() -> void {
+  size = 0;
+  submissionCount = 0;
+  overflow = 0;
+}
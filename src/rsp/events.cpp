@@ -0,0 +1,13 @@
+auto HostEvents::reset() -> void {
+  count = 0;
+  overflow = 0;
+}
+
+auto HostEvents::push(Kind kind, u32 data) -> void {
+  if(rsp.muted) return;
+  if(count < Capacity) queue[count++] = {rsp.clock, kind, data};
+  else overflow++;
+
+  if(!(immediate >> kind & 1)) return;
+  if(callback) callback(kind, data);
+}
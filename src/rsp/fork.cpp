@@ -0,0 +1,188 @@
+auto RSP::saveState(State& state) const -> void {
+  state.clock = Thread::clock;
+  state.functional = functional;
+  state.pipeline = pipeline;
+  state.scheduler = scheduler;
+  state.dma = dma;
+  state.status.semaphore = status.semaphore;
+  state.status.halted = status.halted;
+  state.status.broken = status.broken;
+  state.status.full = status.full;
+  state.status.singleStep = status.singleStep;
+  state.status.interruptOnBreak = status.interruptOnBreak;
+  for(u32 n : range(8)) state.status.signal[n] = status.signal[n];
+  state.dpc = dpc.command;
+  state.ipu = ipu;
+  state.branch = branch;
+  state.vpu = vpu;
+}
+
+auto RSP::loadState(const State& state) -> void {
+  Thread::clock = state.clock;
+  functional = state.functional;
+  pipeline = state.pipeline;
+  timing.reset();
+  scheduler = state.scheduler;
+  dma = state.dma;
+  status.semaphore = state.status.semaphore;
+  status.halted = state.status.halted;
+  status.broken = state.status.broken;
+  status.full = state.status.full;
+  status.singleStep = state.status.singleStep;
+  status.interruptOnBreak = state.status.interruptOnBreak;
+  for(u32 n : range(8)) status.signal[n] = state.status.signal[n];
+  dpc.command = state.dpc;
+  ipu = state.ipu;
+  branch = state.branch;
+  vpu = state.vpu;
+}
+
+//the live RSP always belongs to the 'current' context:
+//its memory matches that context's pages, except for pages flagged as dirty.
+//committing writes those back (copying shared pages first), which keeps forking
+//down to a register file copy plus whatever was modified since the last commit.
+
+auto Contexts::reset() -> void {
+  for(auto& context : contexts) context.used = 0;
+  for(auto& ref : refs) ref = 0;
+
+  //page 0 is a permanently referenced placeholder, never written to
+  refs[0] = 1 + 2 * Pages;
+  freePages = PoolPages - 1;
+
+  current = 0;
+  auto& context = contexts[current];
+  context.used = 1;
+  for(u32 n : range(Pages)) {
+    context.imem[n] = 0;
+    context.dmem[n] = 0;
+  }
+  rsp.saveState(context.state);
+  rsp.imem.dirty = ~0;
+  rsp.dmem.dirty = ~0;
+}
+
+auto Contexts::fork(u32 handle) -> u32 {
+  if(handle >= MaxContexts || !contexts[handle].used) return Invalid;
+
+  u32 target = 0;
+  while(target < MaxContexts && contexts[target].used) target++;
+  if(target == MaxContexts) return Invalid;
+
+  if(handle == current && !commit()) return Invalid;
+
+  auto& source = contexts[handle];
+  auto& fork = contexts[target];
+  fork.used = 1;
+  fork.state = source.state;
+  for(u32 n : range(Pages)) {
+    fork.imem[n] = source.imem[n]; refs[fork.imem[n]]++;
+    fork.dmem[n] = source.dmem[n]; refs[fork.dmem[n]]++;
+  }
+  return target;
+}
+
+auto Contexts::select(u32 handle) -> bool {
+  if(handle >= MaxContexts || !contexts[handle].used) return false;
+  if(handle == current) return true;
+  if(!commit()) return false;
+
+  auto& from = contexts[current];
+  auto& to = contexts[handle];
+  loadPages(rsp.imem, to.imem, from.imem);
+  loadPages(rsp.dmem, to.dmem, from.dmem);
+  rsp.loadState(to.state);
+  current = handle;
+  return true;
+}
+
+auto Contexts::free(u32 handle) -> bool {
+  if(handle >= MaxContexts || !contexts[handle].used || handle == current) return false;
+
+  auto& context = contexts[handle];
+  for(u32 n : range(Pages)) {
+    release(context.imem[n]);
+    release(context.dmem[n]);
+  }
+  context.used = 0;
+  return true;
+}
+
+//replaces the current context's contents with a copy of another one, keeping its handle
+auto Contexts::revert(u32 handle) -> bool {
+  if(handle >= MaxContexts || !contexts[handle].used || handle == current) return false;
+
+  auto& context = contexts[current];
+  auto& source = contexts[handle];
+  sharePages(rsp.imem, context.imem, source.imem);
+  sharePages(rsp.dmem, context.dmem, source.dmem);
+  context.state = source.state;
+  rsp.loadState(source.state);
+  return true;
+}
+
+auto Contexts::allocate() -> u32 {
+  for(u32 page : range(1, PoolPages)) {
+    if(refs[page]) continue;
+    refs[page] = 1;
+    freePages--;
+    return page;
+  }
+  unreachable;
+}
+
+auto Contexts::release(u16 page) -> void {
+  if(--refs[page] == 0) freePages++;
+}
+
+auto Contexts::commit() -> bool {
+  auto& context = contexts[current];
+  if(pagesNeeded(rsp.imem, context.imem) + pagesNeeded(rsp.dmem, context.dmem) > freePages) return false;
+
+  commitPages(rsp.imem, context.imem);
+  commitPages(rsp.dmem, context.dmem);
+  rsp.saveState(context.state);
+  return true;
+}
+
+auto Contexts::commitPages(Memory::Writable& memory, u16* pages) -> void {
+  for(u32 n : range(Pages)) {
+    if(!(memory.dirty >> n & 1)) continue;
+    if(refs[pages[n]] != 1 || !pages[n]) {
+      release(pages[n]);
+      pages[n] = allocate();
+    }
+    __builtin_memcpy(pool[pages[n]], memory.data + n * PageSize, PageSize);
+  }
+  memory.dirty = 0;
+}
+
+auto Contexts::loadPages(Memory::Writable& memory, const u16* pages, const u16* previous) -> void {
+  for(u32 n : range(Pages)) {
+    if(pages[n] == previous[n]) continue;
+    __builtin_memcpy(memory.data + n * PageSize, pool[pages[n]], PageSize);
+    memory.touch(1 << n);
+  }
+  memory.dirty = 0;
+}
+
+auto Contexts::sharePages(Memory::Writable& memory, u16* pages, const u16* source) -> void {
+  for(u32 n : range(Pages)) {
+    if(pages[n] != source[n] || memory.dirty >> n & 1) {
+      __builtin_memcpy(memory.data + n * PageSize, pool[source[n]], PageSize);
+      memory.touch(1 << n);
+    }
+    refs[source[n]]++;
+    release(pages[n]);
+    pages[n] = source[n];
+  }
+  memory.dirty = 0;
+}
+
+auto Contexts::pagesNeeded(const Memory::Writable& memory, const u16* pages) const -> u32 {
+  u32 count = 0;
+  for(u32 n : range(Pages)) {
+    if(memory.dirty >> n & 1 && (refs[pages[n]] != 1 || !pages[n])) count++;
+  }
+  return count;
+}
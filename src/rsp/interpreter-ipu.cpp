@@ -54,10 +54,8 @@ auto RSP::BNE(cr32& rs, cr32& rt, s16 imm) -> void {
 auto RSP::BREAK() -> void {
   status.halted = 1;
   status.broken = 1;
-  if(status.interruptOnBreak) {
-    // @TODO:
-    // mi.raise(MI::IRQ::SP);
-  }
+  hostEvents.push(HostEvents::Break, ipu.pc);
+  if(status.interruptOnBreak) hostEvents.push(HostEvents::Interrupt, 1);
 }
 
 auto RSP::J(u32 imm) -> void {
@@ -27,84 +27,282 @@ static auto countLeadingZeros(u32 value) -> u32 {
 #endif
 }
 
-auto RSP::r128::operator()(u32 index) const -> r128 {
-  r128 v{*this};
-  switch(index) {
-  case  0: break;
-  case  1: break;
-  case  2: v.u16(1) = v.u16(0); v.u16(3) = v.u16(2); v.u16(5) = v.u16(4); v.u16(7) = v.u16(6); break;
-  case  3: v.u16(0) = v.u16(1); v.u16(2) = v.u16(3); v.u16(4) = v.u16(5); v.u16(6) = v.u16(7); break;
-  case  4: v.u16(1) = v.u16(2) = v.u16(3) = v.u16(0); v.u16(5) = v.u16(6) = v.u16(7) = v.u16(4); break;
-  case  5: v.u16(0) = v.u16(2) = v.u16(3) = v.u16(1); v.u16(4) = v.u16(6) = v.u16(7) = v.u16(5); break;
-  case  6: v.u16(0) = v.u16(1) = v.u16(3) = v.u16(2); v.u16(4) = v.u16(5) = v.u16(7) = v.u16(6); break;
-  case  7: v.u16(0) = v.u16(1) = v.u16(2) = v.u16(3); v.u16(4) = v.u16(5) = v.u16(6) = v.u16(7); break;
-  case  8: for(u32 n : range(8)) v.u16(n) = v.u16(0); break;
-  case  9: for(u32 n : range(8)) v.u16(n) = v.u16(1); break;
-  case 10: for(u32 n : range(8)) v.u16(n) = v.u16(2); break;
-  case 11: for(u32 n : range(8)) v.u16(n) = v.u16(3); break;
-  case 12: for(u32 n : range(8)) v.u16(n) = v.u16(4); break;
-  case 13: for(u32 n : range(8)) v.u16(n) = v.u16(5); break;
-  case 14: for(u32 n : range(8)) v.u16(n) = v.u16(6); break;
-  case 15: for(u32 n : range(8)) v.u16(n) = v.u16(7); break;
+//VRCP/VRSQ lookup tables, built at compile time
+struct DivideTables {
+  u16 reciprocals[512];
+  u16 inverseSquareRoots[512];
+
+  constexpr DivideTables() : reciprocals(), inverseSquareRoots() {
+    reciprocals[0] = u16(~0);
+    for(u32 index = 1; index < 512; index++) {
+      u64 a = index + 512;
+      u64 b = (u64(1) << 34) / a;
+      reciprocals[index] = u16(b + 1 >> 8);
+    }
+
+    for(u32 index = 0; index < 512; index++) {
+      u64 a = index + 512 >> (index % 2 == 1);
+      //find the largest b where b < 1.0 / sqrt(a), it is always at least 1 << 17
+      u64 lo = 1 << 17, hi = 1 << 19;
+      while(lo + 1 < hi) {
+        u64 b = lo + hi >> 1;
+        if(a * b * b < (u64(1) << 44)) lo = b; else hi = b;
+      }
+      inverseSquareRoots[index] = u16(lo >> 1);
+    }
+  }
+};
+static constexpr DivideTables divideTables;
+
+//shared by VRCP/VRSQ
+template<bool SQ>
+static auto divideLookup(s32 input) -> s32 {
+  s32 result = 0;
+  s32 mask = input >> 31;
+  s32 data = input ^ mask;
+  if(input > -32768) data -= mask;
+  if(data == 0) {
+    result = 0x7fff'ffff;
+  } else if(input == -32768) {
+    result = 0xffff'0000;
+  } else {
+    u32 shift = countLeadingZeros(data);
+    u32 index = (u64(data) << shift & 0x7fc0'0000) >> 22;
+    if constexpr(!SQ) {
+      result = divideTables.reciprocals[index];
+      result = (0x10000 | result) << 14;
+      result = result >> 31 - shift ^ mask;
+    } else {
+      result = divideTables.inverseSquareRoots[index & 0x1fe | shift & 1];
+      result = (0x10000 | result) << 14;
+      result = result >> (31 - shift >> 1) ^ mask;
+    }
   }
+  return result;
+}
+
+//raw lane k holds element 7 - k
+static constexpr auto broadcastLane(u32 e, u32 k) -> u32 {
+  u32 n = 7 - k;
+  if(e >= 8) n = e - 8;               //single element
+  else if(e >= 4) n = n & ~3 | e - 4;  //one per quarter
+  else if(e >= 2) n = n & ~1 | e - 2;  //one per pair
+  return 7 - n;
+}
+
+//e is known at compile time, so this becomes a single immediate shuffle
+template<uint8_t e>
+auto RSP::r128::broadcast() const -> r128 {
+  if constexpr(e < 2) {
+    return *this;
+  } else {
+    using u16x8 = uint16_t __attribute__((vector_size(16)));
+    u16x8 lanes;
+    __builtin_memcpy(&lanes, this, sizeof(lanes));
+    lanes = __builtin_shufflevector(lanes, lanes,
+      broadcastLane(e, 0), broadcastLane(e, 1), broadcastLane(e, 2), broadcastLane(e, 3),
+      broadcastLane(e, 4), broadcastLane(e, 5), broadcastLane(e, 6), broadcastLane(e, 7));
+    r128 v;
+    __builtin_memcpy(&v, &lanes, sizeof(v));
+    return v;
+  }
+}
+
+//VCx lane masks: element n is 0xffff when bit n is set
+auto RSP::r8::lanes() const -> r128 {
+  using s16x8 = int16_t __attribute__((vector_size(16)));
+  s16x8 select = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};  //raw lane k holds element 7 - k
+  s16x8 mask = (s16x8{} + bits & select) != 0;
+  r128 v;
+  __builtin_memcpy(&v, &mask, sizeof(v));
   return v;
 }
 
-auto RSP::accumulatorGet(u32 index) const -> u64 {
-  return (u64)ACCH.u16(index) << 32 | (u64)ACCM.u16(index) << 16 | (u64)ACCL.u16(index) << 0;
+auto RSP::r8::operator=(cr128& lanes) -> r8& {
+#if ARCHITECTURE_SUPPORTS_SSE4_1
+  //high byte of each lane, element 0 first
+  bits = _mm_movemask_epi8(_mm_shuffle_epi8(lanes, _mm_set_epi8(
+    -1, -1, -1, -1, -1, -1, -1, -1, 1, 3, 5, 7, 9, 11, 13, 15)));
+#elif defined(__wasm_simd128__)
+  using s16x8 = int16_t __attribute__((vector_size(16)));
+  s16x8 v;
+  __builtin_memcpy(&v, &lanes, sizeof(v));
+  v = __builtin_shufflevector(v, v, 7, 6, 5, 4, 3, 2, 1, 0) != 0;
+  bits = __builtin_wasm_bitmask_i16x8(v);
+#else
+  bits = 0;
+  for(u32 n : range(8)) bits |= (lanes.u16(n) != 0) << n;
+#endif
+  return *this;
 }
 
-auto RSP::accumulatorSet(u32 index, u64 value) -> void {
-  ACCH.u16(index) = value >> 32;
-  ACCM.u16(index) = value >> 16;
-  ACCL.u16(index) = value >>  0;
+//one half of an r128 widened to one lane per element: element 4 * half + n in lane n.
+//the helpers work on 128-bit halves so that no 32-byte vector crosses a function boundary.
+static auto lanesSigned(RSP::cr128& v, u32 half) -> RSP::s32x4 {
+  using s16x8 = int16_t __attribute__((vector_size(16)));
+  using s16x4 = int16_t __attribute__((vector_size(8)));
+  s16x8 lanes;
+  __builtin_memcpy(&lanes, &v, sizeof(lanes));
+  s16x4 part = half ? __builtin_shufflevector(lanes, lanes, 3, 2, 1, 0) : __builtin_shufflevector(lanes, lanes, 7, 6, 5, 4);
+  return __builtin_convertvector(part, RSP::s32x4);
 }
 
-auto RSP::accumulatorSaturate(u32 index, bool slice, u16 negative, u16 positive) const -> u16 {
-  if(ACCH.s16(index) < 0) {
-    if(ACCH.u16(index) != 0xffff) return negative;
-    if(ACCM.s16(index) >= 0) return negative;
-  } else {
-    if(ACCH.u16(index) != 0x0000) return positive;
-    if(ACCM.s16(index) < 0) return positive;
+static auto lanesUnsigned(RSP::cr128& v, u32 half) -> RSP::u32x4 {
+  using u16x8 = uint16_t __attribute__((vector_size(16)));
+  using u16x4 = uint16_t __attribute__((vector_size(8)));
+  u16x8 lanes;
+  __builtin_memcpy(&lanes, &v, sizeof(lanes));
+  u16x4 part = half ? __builtin_shufflevector(lanes, lanes, 3, 2, 1, 0) : __builtin_shufflevector(lanes, lanes, 7, 6, 5, 4);
+  return __builtin_convertvector(part, RSP::u32x4);
+}
+
+//16x16 products fit in 32 bits: signed ones sign-extend from bit 31, unsigned ones have no high part
+template<bool SignedS, bool SignedT>
+static auto lanesMultiply(RSP::cr128& s, RSP::cr128& t, u32 half) -> RSP::s32x4 {
+  return (RSP::s32x4)((RSP::u32x4)(SignedS ? (RSP::s32x4)lanesSigned(s, half) : (RSP::s32x4)lanesUnsigned(s, half))
+                    * (RSP::u32x4)(SignedT ? (RSP::s32x4)lanesSigned(t, half) : (RSP::s32x4)lanesUnsigned(t, half)));
+}
+
+//48-bit add, the carry out of the low half moves into the high half
+static auto lanesAdd(const RSP::Accumulator& acc, RSP::u32x4 lo, RSP::s32x4 hi) -> RSP::Accumulator {
+  RSP::u32x4 sum = acc.lo + lo;
+  return {sum, acc.hi + hi - (sum < lo)};
+}
+
+//low 16 bits of each lane, elements 0-3 from 'first' and 4-7 from 'second'
+static auto lanesPack(RSP::s32x4 first, RSP::s32x4 second) -> RSP::r128 {
+  using u16x4 = uint16_t __attribute__((vector_size(8)));
+  using u16x8 = uint16_t __attribute__((vector_size(16)));
+  u16x4 a = __builtin_convertvector(first & 0xffff, u16x4);
+  u16x4 b = __builtin_convertvector(second & 0xffff, u16x4);
+  u16x8 lanes = __builtin_shufflevector(a, b, 7, 6, 5, 4, 3, 2, 1, 0);
+  RSP::r128 r;
+  __builtin_memcpy(&r, &lanes, sizeof(r));
+  return r;
+}
+
+//the multiply ops keep the accumulator as one 48-bit value per lane while 'wide' is set,
+//everything else (and anything outside the VPU) sees the 16-bit slices after accumulatorFlush().
+auto RSP::accumulatorWiden() -> void {
+  if(vpu.wide) return;
+  for(u32 half : range(2)) {
+    accumulatorSet(half, {lanesUnsigned(ACCM, half) << 16 | lanesUnsigned(ACCL, half), (s32x4)lanesUnsigned(ACCH, half)});
   }
-  return !slice ? ACCL.u16(index) : ACCM.u16(index);
+  vpu.wide = 1;
 }
 
-auto RSP::CFC2(r32& rt, u8 rd) -> void {
-  r128 hi, lo;
-  switch(rd & 3) {
-  case 0x00: hi = VCOH; lo = VCOL; break;
-  case 0x01: hi = VCCH; lo = VCCL; break;
-  case 0x02: hi = zero; lo = VCE;  break;
-  case 0x03: hi = zero; lo = VCE;  break;  //unverified
+auto RSP::accumulatorFlush() -> void {
+  if(!vpu.wide) return;
+  Accumulator a = accumulatorGet(0), b = accumulatorGet(1);
+  ACCH = lanesPack(a.hi, b.hi);
+  ACCM = lanesPack((s32x4)(a.lo >> 16), (s32x4)(b.lo >> 16));
+  ACCL = lanesPack((s32x4)a.lo, (s32x4)b.lo);
+  vpu.wide = 0;
+}
+
+auto RSP::accumulatorGet(u32 half) const -> Accumulator {
+  Accumulator acc;
+  __builtin_memcpy(&acc.lo, vpu.acclo + 4 * half, sizeof(acc.lo));
+  __builtin_memcpy(&acc.hi, vpu.acchi + 4 * half, sizeof(acc.hi));
+  return acc;
+}
+
+auto RSP::accumulatorSet(u32 half, const Accumulator& value) -> void {
+  __builtin_memcpy(vpu.acclo + 4 * half, &value.lo, sizeof(value.lo));
+  __builtin_memcpy(vpu.acchi + 4 * half, &value.hi, sizeof(value.hi));
+}
+
+//clamps the middle slice to 16 bits, in range it returns the middle (slice = 1) or low slice
+auto RSP::accumulatorSaturate(bool slice, u16 negative, u16 positive) const -> r128 {
+  s32x4 result[2];
+  for(u32 half : range(2)) {
+    Accumulator acc = accumulatorGet(half);
+    s32x4 md = (s32x4)(acc.lo >> 16) | acc.hi << 16;
+    s32x4 under = md < -32768;
+    s32x4 over  = md > +32767;
+    s32x4 value = slice ? md : (s32x4)acc.lo;
+    result[half] = value & ~(under | over) | (s32x4{} + negative & under) | (s32x4{} + positive & over);
   }
+  return lanesPack(result[0], result[1]);
+}
 
-  rt.u32 = 0;
-  for(u32 n : range(8)) {
-    rt.u32 |= lo.get(n) << 0 + n;
-    rt.u32 |= hi.get(n) << 8 + n;
+auto RSP::CFC2(r32& rt, u8 rd) -> void {
+  u8 hi, lo;
+  switch(rd & 3) {
+  case 0x00: hi = VCOH.bits; lo = VCOL.bits; break;
+  case 0x01: hi = VCCH.bits; lo = VCCL.bits; break;
+  case 0x02: hi = 0;         lo = VCE.bits;  break;
+  case 0x03: hi = 0;         lo = VCE.bits;  break;  //unverified
   }
-  rt.u32 = s16(rt.u32);
+  rt.u32 = s16(hi << 8 | lo << 0);
 }
 
 auto RSP::CTC2(cr32& rt, u8 rd) -> void {
-  r128* hi;
-  r128* lo;
-  r128 null;
   switch(rd & 3) {
-  case 0x00: hi = &VCOH;   lo = &VCOL; break;
-  case 0x01: hi = &VCCH;   lo = &VCCL; break;
-  case 0x02: hi = nullptr; lo = &VCE;  break;
-  case 0x03: hi = nullptr; lo = &VCE;  break;  //unverified
+  case 0x00: VCOH.bits = rt.u32 >> 8; VCOL.bits = rt.u32 >> 0; break;
+  case 0x01: VCCH.bits = rt.u32 >> 8; VCCL.bits = rt.u32 >> 0; break;
+  case 0x02: VCE.bits  = rt.u32 >> 0; break;
+  case 0x03: VCE.bits  = rt.u32 >> 0; break;  //unverified
   }
+}
 
-  for(u32 n : range(8)) {
-    *lo = r128{n, rt.u32 & 1 << 0 + n};
-    *hi = r128{n, rt.u32 & 1 << 8 + n};
+//block fast paths: a register or an aligned 16-byte DMEM block as a big-endian 128-bit value (byte 0 = top of hi).
+//shifting left moves bytes towards index 0.
+struct Bytes16 {
+  u64 hi, lo;
+
+  auto operator|(const Bytes16& b) const -> Bytes16 { return {hi | b.hi, lo | b.lo}; }
+  auto operator&(const Bytes16& b) const -> Bytes16 { return {hi & b.hi, lo & b.lo}; }
+  auto operator~() const -> Bytes16 { return {~hi, ~lo}; }
+
+  auto operator<<(u32 bytes) const -> Bytes16 {
+    u32 bits = bytes * 8;
+    if(bits ==   0) return *this;
+    if(bits >= 128) return {0, 0};
+    if(bits >=  64) return {lo << bits - 64, 0};
+    return {hi << bits | lo >> 64 - bits, lo << bits};
+  }
+
+  auto operator>>(u32 bytes) const -> Bytes16 {
+    u32 bits = bytes * 8;
+    if(bits ==   0) return *this;
+    if(bits >= 128) return {0, 0};
+    if(bits >=  64) return {0, hi >> bits - 64};
+    return {hi >> bits, lo >> bits | hi << 64 - bits};
+  }
+
+  //byte n of the result is byte n + bytes (mod 16) of the source
+  auto rotate(u32 bytes) const -> Bytes16 {
+    bytes &= 15;
+    return *this << bytes | *this >> 16 - bytes;
+  }
+
+  auto element(u32 index) const -> u16 {
+    return (index < 4 ? hi : lo) >> 48 - (index & 3) * 16;
+  }
+
+  auto setElement(u32 index, u16 value) -> void {
+    auto& half = index < 4 ? hi : lo;
+    u32 shift = 48 - (index & 3) * 16;
+    half = half & ~(0xffffull << shift) | (u64)value << shift;
   }
+
+  //the first 'bytes' bytes set
+  static auto head(u32 bytes) -> Bytes16 { return ~(Bytes16{~0ull, ~0ull} >> bytes); }
+};
+
+static auto blockRead(RSP::Writable& memory, u32 address) -> Bytes16 {
+  return {memory.read<Dual>(address + 0), memory.read<Dual>(address + 8)};
+}
+
+static auto blockWrite(RSP::Writable& memory, u32 address, const Bytes16& block) -> void {
+  memory.write<Dual>(address + 0, block.hi);
+  memory.write<Dual>(address + 8, block.lo);
 }
 
+static auto blockOf(RSP::cr128& vt) -> Bytes16 { return {vt.u128.hi, vt.u128.lo}; }
+static auto blockTo(RSP::r128& vt, const Bytes16& block) -> void { vt.u128.hi = block.hi; vt.u128.lo = block.lo; }
+
 template<u8 e>
 auto RSP::LBV(r128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm;
@@ -114,6 +312,12 @@ auto RSP::LBV(r128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::LDV(r128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 8;
+  if constexpr(e == 0 || e == 8) {
+    if(!(address & 7)) {
+      (e == 0 ? vt.u128.hi : vt.u128.lo) = dmem.read<Dual>(address);
+      return;
+    }
+  }
   auto start = e;
   auto end = min(start + 8, 16);
   for(u32 offset = start; offset < end; offset++) {
@@ -151,6 +355,14 @@ auto RSP::LHV(r128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::LLV(r128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 4;
+  if constexpr(!(e & 3)) {
+    if(!(address & 3)) {
+      u32 word = dmem.read<Word>(address);
+      vt.element(e / 2 + 0) = word >> 16;
+      vt.element(e / 2 + 1) = word >>  0;
+      return;
+    }
+  }
   auto start = e;
   auto end = min(start + 4, 16);
   for(u32 offset = start; offset < end; offset++) {
@@ -171,6 +383,12 @@ auto RSP::LPV(r128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::LQV(r128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 16;
+  if constexpr(e == 0) {
+    //bytes up to the end of the 16-byte block, the rest of the register is kept
+    u32 offset = address & 15;
+    blockTo(vt, blockRead(dmem, address & ~15) << offset | blockOf(vt) & ~Bytes16::head(16 - offset));
+    return;
+  }
   auto start = e;
   auto end = min(16 + e - (address & 15), 16);
   for(u32 offset = start; offset < end; offset++) {
@@ -181,6 +399,12 @@ auto RSP::LQV(r128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::LRV(r128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 16;
+  if constexpr(e == 0) {
+    //bytes from the start of the 16-byte block, into the end of the register
+    u32 offset = address & 15;
+    if(offset) blockTo(vt, blockRead(dmem, address & ~15) >> 16 - offset | blockOf(vt) & Bytes16::head(16 - offset));
+    return;
+  }
   auto index = e;
   auto start = 16 - ((address & 15) - index);
   address &= ~15;
@@ -192,6 +416,12 @@ auto RSP::LRV(r128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::LSV(r128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 2;
+  if constexpr(!(e & 1)) {
+    if(!(address & 1)) {
+      vt.element(e / 2) = dmem.read<Half>(address);
+      return;
+    }
+  }
   auto start = e;
   auto end = min(start + 2, 16);
   for(u32 offset = start; offset < end; offset++) {
@@ -201,17 +431,13 @@ auto RSP::LSV(r128& vt, cr32& rs, s8 imm) -> void {
 
 template<u8 e>
 auto RSP::LTV(u8 vt, cr32& rs, s8 imm) -> void {
+  //the 16 bytes starting at the 8-byte aligned address, rotated, are scattered
+  //diagonally: element i goes to register (e/2 + i) & 7 of the group.
   auto address = rs.u32 + imm * 16;
-  auto begin = address & ~7;
-  address = begin + ((e + (address & 8)) & 15);
+  auto block = blockRead(dmem, address & ~7).rotate(e + (address & 8));
   auto vtbase = vt & ~7;
-  auto vtoff = e >> 1;
-  for (u32 i = 0; i < 8; i++) {
-    vpu.r[vtbase + vtoff].byte(i * 2 + 0) = dmem.read<Byte>(address++);
-    if (address == begin + 16) address = begin;
-    vpu.r[vtbase + vtoff].byte(i * 2 + 1) = dmem.read<Byte>(address++);
-    if (address == begin + 16) address = begin;
-    vtoff = vtoff + 1 & 7;
+  for(u32 i : range(8)) {
+    vpu.r[vtbase + (e / 2 + i & 7)].element(i) = block.element(i);
   }
 }
 
@@ -258,6 +484,12 @@ auto RSP::SBV(cr128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::SDV(cr128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 8;
+  if constexpr(e == 0 || e == 8) {
+    if(!(address & 7)) {
+      dmem.write<Dual>(address, e == 0 ? vt.u128.hi : vt.u128.lo);
+      return;
+    }
+  }
   auto start = e;
   auto end = start + 8;
   for(u32 offset = start; offset < end; offset++) {
@@ -337,6 +569,12 @@ auto RSP::SHV(cr128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::SLV(cr128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 4;
+  if constexpr(!(e & 3)) {
+    if(!(address & 3)) {
+      dmem.write<Word>(address, vt.element(e / 2 + 0) << 16 | vt.element(e / 2 + 1) << 0);
+      return;
+    }
+  }
   auto start = e;
   auto end = start + 4;
   for(u32 offset = start; offset < end; offset++) {
@@ -361,6 +599,12 @@ auto RSP::SPV(cr128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::SQV(cr128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 16;
+  if constexpr(e == 0) {
+    u32 offset = address & 15;
+    auto block = blockRead(dmem, address & ~15);
+    blockWrite(dmem, address & ~15, block & Bytes16::head(offset) | blockOf(vt) >> offset);
+    return;
+  }
   auto start = e;
   auto end = start + (16 - (address & 15));
   for(u32 offset = start; offset < end; offset++) {
@@ -371,6 +615,13 @@ auto RSP::SQV(cr128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::SRV(cr128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 16;
+  if constexpr(e == 0) {
+    u32 offset = address & 15;
+    if(!offset) return;
+    auto block = blockRead(dmem, address & ~15);
+    blockWrite(dmem, address & ~15, block & ~Bytes16::head(offset) | blockOf(vt) << 16 - offset);
+    return;
+  }
   auto start = e;
   auto end = start + (address & 15);
   auto base = 16 - (address & 15);
@@ -383,6 +634,12 @@ auto RSP::SRV(cr128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::SSV(cr128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 2;
+  if constexpr(!(e & 1)) {
+    if(!(address & 1)) {
+      dmem.write<Half>(address, vt.element(e / 2));
+      return;
+    }
+  }
   auto start = e;
   auto end = start + 2;
   for(u32 offset = start; offset < end; offset++) {
@@ -392,16 +649,14 @@ auto RSP::SSV(cr128& vt, cr32& rs, s8 imm) -> void {
 
 template<u8 e>
 auto RSP::STV(u8 vt, cr32& rs, s8 imm) -> void {
+  //gather the diagonal (register j supplies element j - e/2), then rotate it into place.
   auto address = rs.u32 + imm * 16;
   auto start = vt & ~7;
-  auto end = start + 8;
-  auto element = 16 - (e & ~1);
-  auto base = (address & 7) - (e & ~1);
-  address &= ~7;
-  for(u32 offset = start; offset < end; offset++) {
-    dmem.write<Byte>(address + (base++ & 15), vpu.r[offset].byte(element++ & 15));
-    dmem.write<Byte>(address + (base++ & 15), vpu.r[offset].byte(element++ & 15));
+  Bytes16 block;
+  for(u32 j : range(8)) {
+    block.setElement(j, vpu.r[start + j].element(j - e / 2 & 7));
   }
+  blockWrite(dmem, address & ~7, block.rotate(16 - ((address & 7) - (e & ~1) & 15)));
 }
 
 template<u8 e>
@@ -421,19 +676,13 @@ auto RSP::SUV(cr128& vt, cr32& rs, s8 imm) -> void {
 template<u8 e>
 auto RSP::SWV(cr128& vt, cr32& rs, s8 imm) -> void {
   auto address = rs.u32 + imm * 16;
-  auto start = e;
-  auto end = start + 16;
-  auto base = address & 7;
-  address &= ~7;
-  for(u32 offset = start; offset < end; offset++) {
-    dmem.write<Byte>(address + (base++ & 15), vt.byte(offset & 15));
-  }
+  blockWrite(dmem, address & ~7, blockOf(vt).rotate(e - (address & 7)));
 }
 
 template<u8 e>
 auto RSP::VABS(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    r128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    r128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       if(vs.s16(n) < 0) {
         if(vte.s16(n) == -32768) {
@@ -453,12 +702,12 @@ auto RSP::VABS(r128& vd, cr128& vs, cr128& vt) -> void {
     }
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
     r128 vs0, slt;
     vs0  = _mm_cmpeq_epi16(vs, zero);
     slt  = _mm_srai_epi16(vs, 15);
-    vd   = _mm_andnot_si128(vs0, vt(e));
+    vd   = _mm_andnot_si128(vs0, vt.broadcast<e>());
     vd   = _mm_xor_si128(vd, slt);
     ACCL = _mm_sub_epi16(vd, slt);
     vd   = _mm_subs_epi16(vd, slt);
@@ -468,8 +717,8 @@ auto RSP::VABS(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VADD(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       s32 result = vs.s16(n) + vte.s16(n) + VCOL.get(n);
       ACCL.s16(n) = result;
@@ -479,14 +728,14 @@ auto RSP::VADD(r128& vd, cr128& vs, cr128& vt) -> void {
     VCOH = zero;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), sum, min, max;
+    r128 vte = vt.broadcast<e>(), carry = VCOL.lanes(), sum, min, max;
     sum  = _mm_add_epi16(vs, vte);
-    ACCL = _mm_sub_epi16(sum, VCOL);
+    ACCL = _mm_sub_epi16(sum, carry);
     min  = _mm_min_epi16(vs, vte);
     max  = _mm_max_epi16(vs, vte);
-    min  = _mm_subs_epi16(min, VCOL);
+    min  = _mm_subs_epi16(min, carry);
     vd   = _mm_adds_epi16(min, max);
     VCOL = zero;
     VCOH = zero;
@@ -496,8 +745,8 @@ auto RSP::VADD(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VADDC(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       u32 result = vs.u16(n) + vte.u16(n);
       ACCL.u16(n) = result;
@@ -507,13 +756,13 @@ auto RSP::VADDC(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), sum;
-    sum  = _mm_adds_epu16(vs, vte);
-    ACCL = _mm_add_epi16(vs, vte);
-    VCOL = _mm_cmpeq_epi16(sum, ACCL);
-    VCOL = _mm_cmpeq_epi16(VCOL, zero);
+    r128 vte = vt.broadcast<e>(), sum, nocarry;
+    sum     = _mm_adds_epu16(vs, vte);
+    ACCL    = _mm_add_epi16(vs, vte);
+    nocarry = _mm_cmpeq_epi16(sum, ACCL);
+    VCOL    = _mm_cmpeq_epi16(nocarry, zero);
     VCOH = zero;
     vd   = ACCL;
     #endif
@@ -522,17 +771,17 @@ auto RSP::VADDC(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VAND(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    r128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    r128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = vs.u16(n) & vte.u16(n);
     }
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    ACCL = _mm_and_si128(vs, vt(e));
+    ACCL = _mm_and_si128(vs, vt.broadcast<e>());
     vd   = ACCL;
     #endif
   }
@@ -540,8 +789,8 @@ auto RSP::VAND(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VCH(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       if((vs.s16(n) ^ vte.s16(n)) < 0) {
         s16 result = vs.s16(n) + vte.s16(n);
@@ -564,26 +813,31 @@ auto RSP::VCH(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), nvt, diff, diff0, vtn, dlez, dgez, mask;
-    VCOL  = _mm_xor_si128(vs, vte);
-    VCOL  = _mm_cmplt_epi16(VCOL, zero);
-    nvt   = _mm_xor_si128(vte, VCOL);
-    nvt   = _mm_sub_epi16(nvt, VCOL);
+    r128 vte = vt.broadcast<e>(), sign, nvt, diff, diff0, vtn, dlez, dgez, ge, le, eq, ne, mask;
+    sign  = _mm_xor_si128(vs, vte);
+    sign  = _mm_cmplt_epi16(sign, zero);
+    nvt   = _mm_xor_si128(vte, sign);
+    nvt   = _mm_sub_epi16(nvt, sign);
     diff  = _mm_sub_epi16(vs, nvt);
     diff0 = _mm_cmpeq_epi16(diff, zero);
     vtn   = _mm_cmplt_epi16(vte, zero);
     dlez  = _mm_cmpgt_epi16(diff, zero);
     dgez  = _mm_or_si128(dlez, diff0);
     dlez  = _mm_cmpeq_epi16(zero, dlez);
-    VCCH  = _mm_blendv_epi8(dgez, vtn, VCOL);
-    VCCL  = _mm_blendv_epi8(vtn, dlez, VCOL);
-    VCE   = _mm_cmpeq_epi16(diff, VCOL);
-    VCE   = _mm_and_si128(VCE, VCOL);
-    VCOH  = _mm_or_si128(diff0, VCE);
-    VCOH  = _mm_cmpeq_epi16(VCOH, zero);
-    mask  = _mm_blendv_epi8(VCCH, VCCL, VCOL);
+    ge    = _mm_blendv_epi8(dgez, vtn, sign);
+    le    = _mm_blendv_epi8(vtn, dlez, sign);
+    eq    = _mm_cmpeq_epi16(diff, sign);
+    eq    = _mm_and_si128(eq, sign);
+    ne    = _mm_or_si128(diff0, eq);
+    ne    = _mm_cmpeq_epi16(ne, zero);
+    VCOL  = sign;
+    VCOH  = ne;
+    VCCH  = ge;
+    VCCL  = le;
+    VCE   = eq;
+    mask  = _mm_blendv_epi8(ge, le, sign);
     ACCL  = _mm_blendv_epi8(vs, nvt, mask);
     vd    = ACCL;
     #endif
@@ -592,8 +846,8 @@ auto RSP::VCH(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VCL(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       if(VCOL.get(n)) {
         if(VCOH.get(n)) {
@@ -621,28 +875,29 @@ auto RSP::VCL(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), nvt, diff, ncarry, nvce, diff0, lec1, lec2, leeq, geeq, le, ge, mask;
-    nvt    = _mm_xor_si128(vte, VCOL);
-    nvt    = _mm_sub_epi16(nvt, VCOL);
+    r128 vte = vt.broadcast<e>(), vcol = VCOL.lanes(), vcoh = VCOH.lanes(), vce = VCE.lanes();
+    r128 nvt, diff, ncarry, nvce, diff0, lec1, lec2, leeq, geeq, le, ge, mask;
+    nvt    = _mm_xor_si128(vte, vcol);
+    nvt    = _mm_sub_epi16(nvt, vcol);
     diff   = _mm_sub_epi16(vs, nvt);
     ncarry = _mm_adds_epu16(vs, vte);
     ncarry = _mm_cmpeq_epi16(diff, ncarry);
-    nvce   = _mm_cmpeq_epi16(VCE, zero);
+    nvce   = _mm_cmpeq_epi16(vce, zero);
     diff0  = _mm_cmpeq_epi16(diff, zero);
     lec1   = _mm_and_si128(diff0, ncarry);
     lec1   = _mm_and_si128(nvce, lec1);
     lec2   = _mm_or_si128(diff0, ncarry);
-    lec2   = _mm_and_si128(VCE, lec2);
+    lec2   = _mm_and_si128(vce, lec2);
     leeq   = _mm_or_si128(lec1, lec2);
     geeq   = _mm_subs_epu16(vte, vs);
     geeq   = _mm_cmpeq_epi16(geeq, zero);
-    le     = _mm_andnot_si128(VCOH, VCOL);
+    le     = _mm_andnot_si128(vcoh, vcol);
     le     = _mm_blendv_epi8(VCCL, leeq, le);
-    ge     = _mm_or_si128(VCOL, VCOH);
+    ge     = _mm_or_si128(vcol, vcoh);
     ge     = _mm_blendv_epi8(geeq, VCCH, ge);
-    mask   = _mm_blendv_epi8(ge, le, VCOL);
+    mask   = _mm_blendv_epi8(ge, le, vcol);
     ACCL   = _mm_blendv_epi8(vs, nvt, mask);
     VCCH   = ge;
     VCCL   = le;
@@ -656,8 +911,8 @@ auto RSP::VCL(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VCR(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       if((vs.s16(n) ^ vte.s16(n)) < 0) {
         VCCH.set(n, vte.s16(n) < 0);
@@ -673,19 +928,21 @@ auto RSP::VCR(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), sign, dlez, dgez, nvt, mask;
+    r128 vte = vt.broadcast<e>(), sign, dlez, dgez, le, ge, nvt, mask;
     sign = _mm_xor_si128(vs, vte);
     sign = _mm_srai_epi16(sign, 15);
     dlez = _mm_and_si128(vs, sign);
     dlez = _mm_add_epi16(dlez, vte);
-    VCCL = _mm_srai_epi16(dlez, 15);
+    le   = _mm_srai_epi16(dlez, 15);
     dgez = _mm_or_si128(vs, sign);
     dgez = _mm_min_epi16(dgez, vte);
-    VCCH = _mm_cmpeq_epi16(dgez, vte);
+    ge   = _mm_cmpeq_epi16(dgez, vte);
     nvt  = _mm_xor_si128(vte, sign);
-    mask = _mm_blendv_epi8(VCCH, VCCL, sign);
+    mask = _mm_blendv_epi8(ge, le, sign);
+    VCCL = le;
+    VCCH = ge;
     ACCL = _mm_blendv_epi8(vs, nvt, mask);
     vd   = ACCL;
     VCOL = zero;
@@ -697,8 +954,8 @@ auto RSP::VCR(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VEQ(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = VCCL.set(n, !VCOH.get(n) && vs.u16(n) == vte.u16(n)) ? vs.u16(n) : vte.u16(n);
     }
@@ -708,12 +965,13 @@ auto RSP::VEQ(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), eq;
+    r128 vte = vt.broadcast<e>(), eq;
     eq   = _mm_cmpeq_epi16(vs, vte);
-    VCCL = _mm_andnot_si128(VCOH, eq);
-    ACCL = _mm_blendv_epi8(vte, vs, VCCL);
+    eq   = _mm_andnot_si128(VCOH, eq);
+    ACCL = _mm_blendv_epi8(vte, vs, eq);
+    VCCL = eq;
     VCCH = zero;  //unverified
     VCOH = zero;
     VCOL = zero;
@@ -724,8 +982,8 @@ auto RSP::VEQ(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VGE(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = VCCL.set(n, vs.s16(n) > vte.s16(n) || (vs.s16(n) == vte.s16(n) && (!VCOL.get(n) || !VCOH.get(n)))) ? vs.u16(n) : vte.u16(n);
     }
@@ -735,15 +993,16 @@ auto RSP::VGE(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), eq, gt, es;
+    r128 vte = vt.broadcast<e>(), eq, gt, es;
     eq   = _mm_cmpeq_epi16(vs, vte);
     gt   = _mm_cmpgt_epi16(vs, vte);
     es   = _mm_and_si128(VCOH, VCOL);
     eq   = _mm_andnot_si128(es, eq);
-    VCCL = _mm_or_si128(gt, eq);
-    ACCL = _mm_blendv_epi8(vte, vs, VCCL);
+    gt   = _mm_or_si128(gt, eq);
+    ACCL = _mm_blendv_epi8(vte, vs, gt);
+    VCCL = gt;
     VCCH = zero;
     VCOH = zero;
     VCOL = zero;
@@ -754,8 +1013,8 @@ auto RSP::VGE(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VLT(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = VCCL.set(n, vs.s16(n) < vte.s16(n) || (vs.s16(n) == vte.s16(n) && VCOL.get(n) && VCOH.get(n))) ? vs.u16(n) : vte.u16(n);
     }
@@ -765,15 +1024,16 @@ auto RSP::VLT(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), eq, lt;
+    r128 vte = vt.broadcast<e>(), eq, lt;
     eq   = _mm_cmpeq_epi16(vs, vte);
     lt   = _mm_cmplt_epi16(vs, vte);
     eq   = _mm_and_si128(VCOH, eq);
     eq   = _mm_and_si128(VCOL, eq);
-    VCCL = _mm_or_si128(lt, eq);
-    ACCL = _mm_blendv_epi8(vte, vs, VCCL);
+    lt   = _mm_or_si128(lt, eq);
+    ACCL = _mm_blendv_epi8(vte, vs, lt);
+    VCCL = lt;
     VCCH = zero;
     VCOH = zero;
     VCOL = zero;
@@ -784,22 +1044,31 @@ auto RSP::VLT(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<bool U, u8 e>
 auto RSP::VMACF(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      accumulatorSet(n, accumulatorGet(n) + (s64)vs.s16(n) * (s64)vte.s16(n) * 2);
-      if constexpr(U == 0) {
-        vd.u16(n) = accumulatorSaturate(n, 1, 0x8000, 0x7fff);
-      }
-      if constexpr(U == 1) {
-        vd.u16(n) = ACCH.s16(n) < 0 ? 0x0000 : ACCH.s16(n) || ACCM.s16(n) < 0 ? 0xffff : ACCM.u16(n);
+  if(Accuracy::RSP::useSISD()) {
+    accumulatorWiden();
+    r128 vte = vt.broadcast<e>();
+    for(u32 half : range(2)) {
+      s32x4 product = lanesMultiply<true, true>(vs, vte, half);
+      accumulatorSet(half, lanesAdd(accumulatorGet(half), (u32x4)product << 1, product >> 31));
+    }
+    if constexpr(U == 0) {
+      vd = accumulatorSaturate(1, 0x8000, 0x7fff);
+    }
+    if constexpr(U == 1) {
+      s32x4 result[2];
+      for(u32 half : range(2)) {
+        Accumulator acc = accumulatorGet(half);
+        s32x4 hi = acc.hi << 16 >> 16;
+        s32x4 md = (s32x4)acc.lo >> 16;
+        result[half] = (md | (hi != 0 | md < 0)) & ~(hi < 0);
       }
+      vd = lanesPack(result[0], result[1]);
     }
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), lo, md, hi, carry, omask;
+    r128 vte = vt.broadcast<e>(), lo, md, hi, carry, omask;
     lo    = _mm_mullo_epi16(vs, vte);
     hi    = _mm_mulhi_epi16(vs, vte);
     md    = _mm_slli_epi16(hi, 1);
@@ -851,19 +1120,19 @@ auto RSP::VMACQ(r128& vd) -> void {
 
 template<u8 e>
 auto RSP::VMADH(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      s32 result = (accumulatorGet(n) >> 16) + vs.s16(n) * vte.s16(n);
-      ACCH.u16(n) = result >> 16;
-      ACCM.u16(n) = result >>  0;
-      vd.u16(n) = accumulatorSaturate(n, 1, 0x8000, 0x7fff);
+  if(Accuracy::RSP::useSISD()) {
+    accumulatorWiden();
+    r128 vte = vt.broadcast<e>();
+    for(u32 half : range(2)) {
+      s32x4 product = lanesMultiply<true, true>(vs, vte, half);
+      accumulatorSet(half, lanesAdd(accumulatorGet(half), (u32x4)product << 16, product >> 16));
     }
+    vd = accumulatorSaturate(1, 0x8000, 0x7fff);
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), lo, hi, omask;
+    r128 vte = vt.broadcast<e>(), lo, hi, omask;
     lo    = _mm_mullo_epi16(vs, vte);
     hi    = _mm_mulhi_epi16(vs, vte);
     omask = _mm_adds_epu16(ACCM, lo);
@@ -881,17 +1150,19 @@ auto RSP::VMADH(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VMADL(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      accumulatorSet(n, accumulatorGet(n) + (u32(vs.u16(n) * vte.u16(n)) >> 16));
-      vd.u16(n) = accumulatorSaturate(n, 0, 0x0000, 0xffff);
+  if(Accuracy::RSP::useSISD()) {
+    accumulatorWiden();
+    r128 vte = vt.broadcast<e>();
+    for(u32 half : range(2)) {
+      s32x4 product = lanesMultiply<false, false>(vs, vte, half);
+      accumulatorSet(half, lanesAdd(accumulatorGet(half), (u32x4)product >> 16, s32x4{}));
     }
+    vd = accumulatorSaturate(0, 0x0000, 0xffff);
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), hi, omask, nhi, nmd, shi, smd, cmask, cval;
+    r128 vte = vt.broadcast<e>(), hi, omask, nhi, nmd, shi, smd, cmask, cval;
     hi    = _mm_mulhi_epu16(vs, vte);
     omask = _mm_adds_epu16(ACCL, hi);
     ACCL  = _mm_add_epi16(ACCL, hi);
@@ -916,17 +1187,19 @@ auto RSP::VMADL(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VMADM(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      accumulatorSet(n, accumulatorGet(n) + vs.s16(n) * vte.u16(n));
-      vd.u16(n) = accumulatorSaturate(n, 1, 0x8000, 0x7fff);
+  if(Accuracy::RSP::useSISD()) {
+    accumulatorWiden();
+    r128 vte = vt.broadcast<e>();
+    for(u32 half : range(2)) {
+      s32x4 product = lanesMultiply<true, false>(vs, vte, half);
+      accumulatorSet(half, lanesAdd(accumulatorGet(half), (u32x4)product, product >> 31));
     }
+    vd = accumulatorSaturate(1, 0x8000, 0x7fff);
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), lo, hi, sign, vta, omask;
+    r128 vte = vt.broadcast<e>(), lo, hi, sign, vta, omask;
     lo    = _mm_mullo_epi16(vs, vte);
     hi    = _mm_mulhi_epu16(vs, vte);
     sign  = _mm_srai_epi16(vs, 15);
@@ -953,17 +1226,19 @@ auto RSP::VMADM(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VMADN(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      accumulatorSet(n, accumulatorGet(n) + s64(vs.u16(n) * vte.s16(n)));
-      vd.u16(n) = accumulatorSaturate(n, 0, 0x0000, 0xffff);
+  if(Accuracy::RSP::useSISD()) {
+    accumulatorWiden();
+    r128 vte = vt.broadcast<e>();
+    for(u32 half : range(2)) {
+      s32x4 product = lanesMultiply<false, true>(vs, vte, half);
+      accumulatorSet(half, lanesAdd(accumulatorGet(half), (u32x4)product, product >> 31));
     }
+    vd = accumulatorSaturate(0, 0x0000, 0xffff);
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), lo, hi, sign, vsa, omask, nhi, nmd, shi, smd, cmask, cval;
+    r128 vte = vt.broadcast<e>(), lo, hi, sign, vsa, omask, nhi, nmd, shi, smd, cmask, cval;
     lo    = _mm_mullo_epi16(vs, vte);
     hi    = _mm_mulhi_epu16(vs, vte);
     sign  = _mm_srai_epi16(vte, 15);
@@ -994,15 +1269,15 @@ auto RSP::VMADN(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VMOV(r128& vd, u8 de, cr128& vt) -> void {
-  cr128 vte = vt(e);
+  cr128 vte = vt.broadcast<e>();
   vd.u16(de) = vte.u16(de);
   ACCL = vte;
 }
 
 template<u8 e>
 auto RSP::VMRG(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = VCCL.get(n) ? vs.u16(n) : vte.u16(n);
     }
@@ -1011,9 +1286,9 @@ auto RSP::VMRG(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    ACCL = _mm_blendv_epi8(vt(e), vs, VCCL);
+    ACCL = _mm_blendv_epi8(vt.broadcast<e>(), vs, VCCL);
     VCOH = zero;
     VCOL = zero;
     vd   = ACCL;
@@ -1023,17 +1298,19 @@ auto RSP::VMRG(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VMUDH(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      accumulatorSet(n, s64(vs.s16(n) * vte.s16(n)) << 16);
-      vd.u16(n) = accumulatorSaturate(n, 1, 0x8000, 0x7fff);
+  if(Accuracy::RSP::useSISD()) {
+    vpu.wide = 1;  //all lanes are overwritten
+    r128 vte = vt.broadcast<e>();
+    for(u32 half : range(2)) {
+      s32x4 product = lanesMultiply<true, true>(vs, vte, half);
+      accumulatorSet(half, {(u32x4)product << 16, product >> 16});
     }
+    vd = accumulatorSaturate(1, 0x8000, 0x7fff);
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), lo, hi;
+    r128 vte = vt.broadcast<e>(), lo, hi;
     ACCL = zero;
     ACCM = _mm_mullo_epi16(vs, vte);
     ACCH = _mm_mulhi_epi16(vs, vte);
@@ -1046,17 +1323,21 @@ auto RSP::VMUDH(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VMUDL(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      accumulatorSet(n, u16(vs.u16(n) * vte.u16(n) >> 16));
+  if(Accuracy::RSP::useSISD()) {
+    vpu.wide = 1;  //all lanes are overwritten
+    r128 vte = vt.broadcast<e>();
+    s32x4 result[2];
+    for(u32 half : range(2)) {
+      u32x4 product = (u32x4)lanesMultiply<false, false>(vs, vte, half) >> 16;
+      accumulatorSet(half, {product, s32x4{}});
+      result[half] = (s32x4)product;
     }
-    vd = ACCL;
+    vd = lanesPack(result[0], result[1]);
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    ACCL = _mm_mulhi_epu16(vs, vt(e));
+    ACCL = _mm_mulhi_epu16(vs, vt.broadcast<e>());
     ACCM = zero;
     ACCH = zero;
     vd   = ACCL;
@@ -1066,17 +1347,21 @@ auto RSP::VMUDL(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VMUDM(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      accumulatorSet(n, s32(vs.s16(n) * vte.u16(n)));
+  if(Accuracy::RSP::useSISD()) {
+    vpu.wide = 1;  //all lanes are overwritten
+    r128 vte = vt.broadcast<e>();
+    s32x4 result[2];
+    for(u32 half : range(2)) {
+      s32x4 product = lanesMultiply<true, false>(vs, vte, half);
+      accumulatorSet(half, {(u32x4)product, product >> 31});
+      result[half] = product >> 16;
     }
-    vd = ACCM;
+    vd = lanesPack(result[0], result[1]);
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), sign, vta;
+    r128 vte = vt.broadcast<e>(), sign, vta;
     ACCL = _mm_mullo_epi16(vs, vte);
     ACCM = _mm_mulhi_epu16(vs, vte);
     sign = _mm_srai_epi16(vs, 15);
@@ -1090,17 +1375,21 @@ auto RSP::VMUDM(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VMUDN(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      accumulatorSet(n, s32(vs.u16(n) * vte.s16(n)));
+  if(Accuracy::RSP::useSISD()) {
+    vpu.wide = 1;  //all lanes are overwritten
+    r128 vte = vt.broadcast<e>();
+    s32x4 result[2];
+    for(u32 half : range(2)) {
+      s32x4 product = lanesMultiply<false, true>(vs, vte, half);
+      accumulatorSet(half, {(u32x4)product, product >> 31});
+      result[half] = product;
     }
-    vd = ACCL;
+    vd = lanesPack(result[0], result[1]);
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), sign, vsa;
+    r128 vte = vt.broadcast<e>(), sign, vsa;
     ACCL = _mm_mullo_epi16(vs, vte);
     ACCM = _mm_mulhi_epu16(vs, vte);
     sign = _mm_srai_epi16(vte, 15);
@@ -1114,22 +1403,31 @@ auto RSP::VMUDN(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<bool U, u8 e>
 auto RSP::VMULF(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
-    for(u32 n : range(8)) {
-      accumulatorSet(n, (s64)vs.s16(n) * (s64)vte.s16(n) * 2 + 0x8000);
-      if constexpr(U == 0) {
-        vd.u16(n) = accumulatorSaturate(n, 1, 0x8000, 0x7fff);
-      }
-      if constexpr(U == 1) {
-        vd.u16(n) = ACCH.s16(n) < 0 ? 0x0000 : (ACCH.s16(n) ^ ACCM.s16(n)) < 0 ? 0xffff : ACCM.u16(n);
+  if(Accuracy::RSP::useSISD()) {
+    vpu.wide = 1;  //all lanes are overwritten
+    r128 vte = vt.broadcast<e>();
+    for(u32 half : range(2)) {
+      s32x4 product = lanesMultiply<true, true>(vs, vte, half);
+      accumulatorSet(half, lanesAdd({(u32x4)product << 1, product >> 31}, u32x4{} + 0x8000, s32x4{}));
+    }
+    if constexpr(U == 0) {
+      vd = accumulatorSaturate(1, 0x8000, 0x7fff);
+    }
+    if constexpr(U == 1) {
+      s32x4 result[2];
+      for(u32 half : range(2)) {
+        Accumulator acc = accumulatorGet(half);
+        s32x4 hi = acc.hi << 16 >> 16;
+        s32x4 md = (s32x4)acc.lo >> 16;
+        result[half] = (md | (hi ^ md) < 0) & ~(hi < 0);
       }
+      vd = lanesPack(result[0], result[1]);
     }
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), lo, hi, round, sign1, sign2, neq, eq, neg;
+    r128 vte = vt.broadcast<e>(), lo, hi, round, sign1, sign2, neq, eq, neg;
     lo    = _mm_mullo_epi16(vs, vte);
     round = _mm_cmpeq_epi16(zero, zero);
     sign1 = _mm_srli_epi16(lo, 15);
@@ -1158,7 +1456,7 @@ auto RSP::VMULF(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VMULQ(r128& vd, cr128& vs, cr128& vt) -> void {
-  cr128 vte = vt(e);
+  cr128 vte = vt.broadcast<e>();
   for(u32 n : range(8)) {
     s32 product = (s16)vs.element(n) * (s16)vte.element(n);
     if(product < 0) product += 31;  //round
@@ -1171,17 +1469,17 @@ auto RSP::VMULQ(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VNAND(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = ~(vs.u16(n) & vte.u16(n));
     }
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    ACCL = _mm_and_si128(vs, vt(e));
+    ACCL = _mm_and_si128(vs, vt.broadcast<e>());
     ACCL = _mm_xor_si128(ACCL, invert);
     vd   = ACCL;
     #endif
@@ -1190,8 +1488,8 @@ auto RSP::VNAND(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VNE(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = VCCL.set(n, vs.u16(n) != vte.u16(n) || VCOH.get(n)) ? vs.u16(n) : vte.u16(n);
     }
@@ -1201,14 +1499,15 @@ auto RSP::VNE(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), eq, ne;
+    r128 vte = vt.broadcast<e>(), eq, ne;
     eq   = _mm_cmpeq_epi16(vs, vte);
     ne   = _mm_cmpeq_epi16(eq, zero);
-    VCCL = _mm_and_si128(VCOH, eq);
-    VCCL = _mm_or_si128(VCCL, ne);
-    ACCL = _mm_blendv_epi8(vte, vs, VCCL);
+    eq   = _mm_and_si128(VCOH, eq);
+    ne   = _mm_or_si128(eq, ne);
+    ACCL = _mm_blendv_epi8(vte, vs, ne);
+    VCCL = ne;
     VCCH = zero;
     VCOH = zero;
     VCOL = zero;
@@ -1222,17 +1521,17 @@ auto RSP::VNOP() -> void {
 
 template<u8 e>
 auto RSP::VNOR(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = ~(vs.u16(n) | vte.u16(n));
     }
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    ACCL = _mm_or_si128(vs, vt(e));
+    ACCL = _mm_or_si128(vs, vt.broadcast<e>());
     ACCL = _mm_xor_si128(ACCL, invert);
     vd   = ACCL;
     #endif
@@ -1241,17 +1540,17 @@ auto RSP::VNOR(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VNXOR(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = ~(vs.u16(n) ^ vte.u16(n));
     }
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    ACCL = _mm_xor_si128(vs, vt(e));
+    ACCL = _mm_xor_si128(vs, vt.broadcast<e>());
     ACCL = _mm_xor_si128(ACCL, invert);
     vd   = ACCL;
     #endif
@@ -1260,17 +1559,17 @@ auto RSP::VNXOR(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VOR(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = vs.u16(n) | vte.u16(n);
     }
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    ACCL = _mm_or_si128(vs, vt(e));
+    ACCL = _mm_or_si128(vs, vt.broadcast<e>());
     vd   = ACCL;
     #endif
   }
@@ -1278,31 +1577,17 @@ auto RSP::VOR(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<bool L, u8 e>
 auto RSP::VRCP(r128& vd, u8 de, cr128& vt) -> void {
-  s32 result = 0;
   s32 input = L && DIVDP ? DIVIN << 16 | vt.element(e & 7) : s16(vt.element(e & 7));
-  s32 mask = input >> 31;
-  s32 data = input ^ mask;
-  if(input > -32768) data -= mask;
-  if(data == 0) {
-    result = 0x7fff'ffff;
-  } else if(input == -32768) {
-    result = 0xffff'0000;
-  } else {
-    u32 shift = countLeadingZeros(data);
-    u32 index = (u64(data) << shift & 0x7fc0'0000) >> 22;
-    result = reciprocals[index];
-    result = (0x10000 | result) << 14;
-    result = result >> 31 - shift ^ mask;
-  }
+  s32 result = divideLookup<false>(input);
   DIVDP = 0;
   DIVOUT = result >> 16;
-  ACCL = vt(e);
+  ACCL = vt.broadcast<e>();
   vd.element(de) = result;
 }
 
 template<u8 e>
 auto RSP::VRCPH(r128& vd, u8 de, cr128& vt) -> void {
-  ACCL  = vt(e);
+  ACCL  = vt.broadcast<e>();
   DIVDP = 1;
   DIVIN = vt.element(e & 7);
   vd.element(de) = DIVOUT;
@@ -1310,7 +1595,7 @@ auto RSP::VRCPH(r128& vd, u8 de, cr128& vt) -> void {
 
 template<bool D, u8 e>
 auto RSP::VRND(r128& vd, u8 vs, cr128& vt) -> void {
-  cr128 vte = vt(e);
+  cr128 vte = vt.broadcast<e>();
   for(u32 n : range(8)) {
     s32 product = (s16)vte.element(n);
     if(vs & 1) product <<= 16;
@@ -1330,31 +1615,17 @@ auto RSP::VRND(r128& vd, u8 vs, cr128& vt) -> void {
 
 template<bool L, u8 e>
 auto RSP::VRSQ(r128& vd, u8 de, cr128& vt) -> void {
-  s32 result = 0;
   s32 input = L && DIVDP ? DIVIN << 16 | vt.element(e & 7) : s16(vt.element(e & 7));
-  s32 mask = input >> 31;
-  s32 data = input ^ mask;
-  if(input > -32768) data -= mask;
-  if(data == 0) {
-    result = 0x7fff'ffff;
-  } else if(input == -32768) {
-    result = 0xffff'0000;
-  } else {
-    u32 shift = countLeadingZeros(data);
-    u32 index = (u64(data) << shift & 0x7fc0'0000) >> 22;
-    result = inverseSquareRoots[index & 0x1fe | shift & 1];
-    result = (0x10000 | result) << 14;
-    result = result >> (31 - shift >> 1) ^ mask;
-  }
+  s32 result = divideLookup<true>(input);
   DIVDP = 0;
   DIVOUT = result >> 16;
-  ACCL = vt(e);
+  ACCL = vt.broadcast<e>();
   vd.element(de) = result;
 }
 
 template<u8 e>
 auto RSP::VRSQH(r128& vd, u8 de, cr128& vt) -> void {
-  ACCL  = vt(e);
+  ACCL  = vt.broadcast<e>();
   DIVDP = 1;
   DIVIN = vt.element(e & 7);
   vd.element(de) = DIVOUT;
@@ -1372,8 +1643,8 @@ auto RSP::VSAR(r128& vd, cr128& vs) -> void {
 
 template<u8 e>
 auto RSP::VSUB(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       s32 result = vs.s16(n) - vte.s16(n) - VCOL.get(n);
       ACCL.s16(n) = result;
@@ -1383,11 +1654,11 @@ auto RSP::VSUB(r128& vd, cr128& vs, cr128& vt) -> void {
     VCOH = zero;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), udiff, sdiff, ov;
-    udiff = _mm_sub_epi16(vte, VCOL);
-    sdiff = _mm_subs_epi16(vte, VCOL);
+    r128 vte = vt.broadcast<e>(), borrow = VCOL.lanes(), udiff, sdiff, ov;
+    udiff = _mm_sub_epi16(vte, borrow);
+    sdiff = _mm_subs_epi16(vte, borrow);
     ACCL  = _mm_sub_epi16(vs, udiff);
     ov    = _mm_cmpgt_epi16(sdiff, udiff);
     vd    = _mm_subs_epi16(vs, sdiff);
@@ -1400,8 +1671,8 @@ auto RSP::VSUB(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VSUBC(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       u32 result = vs.u16(n) - vte.u16(n);
       ACCL.u16(n) = result;
@@ -1411,9 +1682,9 @@ auto RSP::VSUBC(r128& vd, cr128& vs, cr128& vt) -> void {
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), equal, udiff, diff0;
+    r128 vte = vt.broadcast<e>(), equal, udiff, diff0;
     udiff = _mm_subs_epu16(vs, vte);
     equal = _mm_cmpeq_epi16(vs, vte);
     diff0 = _mm_cmpeq_epi16(udiff, zero);
@@ -1427,17 +1698,17 @@ auto RSP::VSUBC(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VXOR(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       ACCL.u16(n) = vs.u16(n) ^ vte.u16(n);
     }
     vd = ACCL;
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    ACCL = _mm_xor_si128(vs, vt(e));
+    ACCL = _mm_xor_si128(vs, vt.broadcast<e>());
     vd   = ACCL;
     #endif
   }
@@ -1445,8 +1716,8 @@ auto RSP::VXOR(r128& vd, cr128& vs, cr128& vt) -> void {
 
 template<u8 e>
 auto RSP::VZERO(r128& vd, cr128& vs, cr128& vt) -> void {
-  if constexpr(Accuracy::RSP::SISD) {
-    cr128 vte = vt(e);
+  if(Accuracy::RSP::useSISD()) {
+    cr128 vte = vt.broadcast<e>();
     for(u32 n : range(8)) {
       s32 result = vs.s16(n) + vte.s16(n);
       ACCL.s16(n) = result;
@@ -1454,9 +1725,9 @@ auto RSP::VZERO(r128& vd, cr128& vs, cr128& vt) -> void {
     }
   }
 
-  if constexpr(Accuracy::RSP::SIMD) {
+  if(Accuracy::RSP::useSIMD()) {
     #if ARCHITECTURE_SUPPORTS_SSE4_1
-    r128 vte = vt(e), sum, min, max;
+    r128 vte = vt.broadcast<e>(), sum, min, max;
     ACCL = _mm_add_epi16(vs, vte);
     vd   = _mm_xor_si128(vd, vd);
     #endif
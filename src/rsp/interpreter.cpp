@@ -9,26 +9,7 @@
 #define jp(id, name, ...) case id: return interpreter##name(__VA_ARGS__)
 #define op(id, name, ...) case id: return name(__VA_ARGS__)
 #define br(id, name, ...) case id: return name(__VA_ARGS__)
-#define vu(id, name, ...) case id: \
-  switch(E) { \
-  case 0x0: return name<0x0>(__VA_ARGS__); \
-  case 0x1: return name<0x1>(__VA_ARGS__); \
-  case 0x2: return name<0x2>(__VA_ARGS__); \
-  case 0x3: return name<0x3>(__VA_ARGS__); \
-  case 0x4: return name<0x4>(__VA_ARGS__); \
-  case 0x5: return name<0x5>(__VA_ARGS__); \
-  case 0x6: return name<0x6>(__VA_ARGS__); \
-  case 0x7: return name<0x7>(__VA_ARGS__); \
-  case 0x8: return name<0x8>(__VA_ARGS__); \
-  case 0x9: return name<0x9>(__VA_ARGS__); \
-  case 0xa: return name<0xa>(__VA_ARGS__); \
-  case 0xb: return name<0xb>(__VA_ARGS__); \
-  case 0xc: return name<0xc>(__VA_ARGS__); \
-  case 0xd: return name<0xd>(__VA_ARGS__); \
-  case 0xe: return name<0xe>(__VA_ARGS__); \
-  case 0xf: return name<0xf>(__VA_ARGS__); \
-  } \
-  unreachable;
+#define vu(id, name, ...) case id: return name<e>(__VA_ARGS__)
 
 #define SA     (OP >>  6 & 31)
 #define RDn    (OP >> 11 & 31)
@@ -41,8 +22,40 @@
 #define IMMu16 u16(OP)
 #define IMMu26 (OP & 0x03ff'ffff)
 
+//handlers that take part of the instruction as a template parameter are instantiated once per value,
+//dispatch is then a single lookup into a constexpr table built from an integer sequence.
+template<typename T, T... n> struct sequence {};
+#if __has_builtin(__make_integer_seq)
+template<u32 size> using makeSequence = __make_integer_seq<sequence, u32, size>;
+#else
+template<u32 size> using makeSequence = sequence<u32, __integer_pack(size)...>;
+#endif
+
+template<typename T, u32 size> struct HandlerTable {
+  T entries[size];
+  auto operator[](u32 index) const -> T { return entries[index]; }
+};
+
+template<typename T, template<u32> typename Entry, u32... n>
+static constexpr auto handlerTable(sequence<u32, n...>) -> HandlerTable<T, sizeof...(n)> {
+  return {{Entry<n>::entry...}};
+}
+
+//VU, LWC2 and SWC2 index: op << 4 | element
+template<u32 n> struct EXECUTEOp  { static constexpr RSP::Handler entry = &RSP::interpreterEXECUTE<n>; };
+template<u32 n> struct VUTransfer { static constexpr RSP::Handler entry = &RSP::interpreterVUTransfer<(n >> 4), (n & 15)>; };
+template<u32 n> struct VUCompute  { static constexpr RSP::Handler entry = &RSP::interpreterVUCompute<(n >> 4), (n & 15)>; };
+template<u32 n> struct LWC2Op     { static constexpr RSP::Handler entry = &RSP::interpreterLWC2<(n >> 4), (n & 15)>; };
+template<u32 n> struct SWC2Op     { static constexpr RSP::Handler entry = &RSP::interpreterSWC2<(n >> 4), (n & 15)>; };
+
 auto RSP::interpreterEXECUTE() -> void {
-  switch(OP >> 26) {
+  static constexpr auto table = handlerTable<Handler, EXECUTEOp>(makeSequence<64>{});
+  return (this->*table[OP >> 26])();
+}
+
+template<u8 id>
+auto RSP::interpreterEXECUTE() -> void {
+  switch(id) {
   jp(0x00, SPECIAL);
   jp(0x01, REGIMM);
   br(0x02, J, IMMu26);
@@ -238,8 +251,19 @@ auto RSP::interpreterSCC() -> void {
 }
 
 auto RSP::interpreterVU() -> void {
-  #define E (OP >> 7 & 15)
-  switch(OP >> 21 & 0x1f) {
+#if defined(RSP_VPU_CROSSCHECK)
+  if(!crossCheck.active) return crossCheckVU();
+#endif
+
+  static constexpr auto transfer = handlerTable<Handler, VUTransfer>(makeSequence<16 * 16>{});
+  static constexpr auto compute  = handlerTable<Handler, VUCompute>(makeSequence<64 * 16>{});
+  if(OP & 1 << 25) return (this->*compute[(OP & 0x3f) << 4 | OP >> 21 & 15])();
+  return (this->*transfer[(OP >> 21 & 15) << 4 | OP >> 7 & 15])();
+}
+
+template<u8 id, u8 e>
+auto RSP::interpreterVUTransfer() -> void {
+  switch(id) {
   vu(0x00, MFC2, RT, VS);
   op(0x01, INVALID);  //DMFC2
   op(0x02, CFC2, RT, RDn);
@@ -257,11 +281,15 @@ auto RSP::interpreterVU() -> void {
   op(0x0e, INVALID);
   op(0x0f, INVALID);
   }
-  #undef E
+}
 
-  #define E  (OP >> 21 & 15)
-  #define DE (OP >> 11 &  7)
-  switch(OP & 0x3f) {
+template<u8 id, u8 e>
+auto RSP::interpreterVUCompute() -> void {
+  //only the multiply-accumulate group works on the wide accumulator
+  if constexpr(id & 0x30 || !(0xf3f3 >> (id & 0x0f) & 1)) accumulatorFlush();
+
+  #define DE (OP >> 11 & 7)
+  switch(id) {
   vu(0x00, VMULF, VD, VS, VT);
   vu(0x01, VMULU, VD, VS, VT);
   vu(0x02, VRNDP, VD, VSn, VT);
@@ -327,14 +355,18 @@ auto RSP::interpreterVU() -> void {
   vu(0x3e, VZERO, VD, VS, VT); //VINSN
   op(0x3f, VNOP); //VNULL
   }
-  #undef E
   #undef DE
 }
 
 auto RSP::interpreterLWC2() -> void {
-  #define E     (OP >> 7 & 15)
+  static constexpr auto table = handlerTable<Handler, LWC2Op>(makeSequence<32 * 16>{});
+  return (this->*table[(OP >> 11 & 0x1f) << 4 | OP >> 7 & 15])();
+}
+
+template<u8 id, u8 e>
+auto RSP::interpreterLWC2() -> void {
   #define IMMi7 i7(OP)
-  switch(OP >> 11 & 0x1f) {
+  switch(id) {
   vu(0x00, LBV, VT, RS, IMMi7);
   vu(0x01, LSV, VT, RS, IMMi7);
   vu(0x02, LLV, VT, RS, IMMi7);
@@ -348,14 +380,18 @@ auto RSP::interpreterLWC2() -> void {
 //vu(0x0a, LWV, VT, RS, IMMi7);  //not present on N64 RSP
   vu(0x0b, LTV, VTn, RS, IMMi7);
   }
-  #undef E
   #undef IMMi7
 }
 
 auto RSP::interpreterSWC2() -> void {
-  #define E     (OP >> 7 & 15)
+  static constexpr auto table = handlerTable<Handler, SWC2Op>(makeSequence<32 * 16>{});
+  return (this->*table[(OP >> 11 & 0x1f) << 4 | OP >> 7 & 15])();
+}
+
+template<u8 id, u8 e>
+auto RSP::interpreterSWC2() -> void {
   #define IMMi7 i7(OP)
-  switch(OP >> 11 & 0x1f) {
+  switch(id) {
   vu(0x00, SBV, VT, RS, IMMi7);
   vu(0x01, SSV, VT, RS, IMMi7);
   vu(0x02, SLV, VT, RS, IMMi7);
@@ -369,7 +405,6 @@ auto RSP::interpreterSWC2() -> void {
   vu(0x0a, SWV, VT, RS, IMMi7);
   vu(0x0b, STV, VTn, RS, IMMi7);
   }
-  #undef E
   #undef IMMi7
 }
 
@@ -50,11 +50,13 @@ auto RSP::ioRead(u32 address, Thread &thread) -> u32 {
   if(address == 5) {
     //SP_DMA_FULL
     data.bit(0) = dma.full.any();
+    dmaPoll(DMAStats::Full, data.bit(0));
   }
 
   if(address == 6) {
     //SP_DMA_BUSY
     data.bit(0) = dma.busy.any();
+    dmaPoll(DMAStats::Busy, data.bit(0));
   }
 
   if(address == 7) {
@@ -96,6 +98,7 @@ auto RSP::ioWrite(u32 address, u32 data_, Thread& thread) -> void {
     dma.pending.skip.bit(3,11)   = data.bit(23,31);
     dma.full.read  = 1;
     dma.full.write = 0;
+    dmaStats.queued = thread.clock;
     // printf("RSP DMA Read: %08x => %08x %08x\n", dma.pending.dramAddress, dma.pending.pbusAddress, dma.pending.length);
     dmaTransferStart(thread);
   }
@@ -107,18 +110,20 @@ auto RSP::ioWrite(u32 address, u32 data_, Thread& thread) -> void {
     dma.pending.skip.bit(3,11)   = data.bit(23,31);
     dma.full.write = 1;
     dma.full.read  = 0;
+    dmaStats.queued = thread.clock;
     dmaTransferStart(thread);
   }
 
   if(address == 4) {
     //SP_STATUS
+    u32 signals = 0;
+    for(u32 n : range(8)) signals |= status.signal[n] << n;
+
     if(data.bit( 0) && !data.bit( 1)) status.halted = 0;
     if(data.bit( 1) && !data.bit( 0)) status.halted = 1;
     if(data.bit( 2)) status.broken = 0;
-
-// @TODO:
-//    if(data.bit( 3) && !data.bit( 4)) mi.lower(MI::IRQ::SP);
-//    if(data.bit( 4) && !data.bit( 3)) mi.raise(MI::IRQ::SP);
+    if(data.bit( 3) && !data.bit( 4)) hostEvents.push(HostEvents::Interrupt, 0);
+    if(data.bit( 4) && !data.bit( 3)) hostEvents.push(HostEvents::Interrupt, 1);
 
     if(data.bit( 5) && !data.bit( 6)) status.singleStep = 0;
     if(data.bit( 6) && !data.bit( 5)) status.singleStep = 1;
@@ -140,6 +145,10 @@ auto RSP::ioWrite(u32 address, u32 data_, Thread& thread) -> void {
     if(data.bit(22) && !data.bit(21)) status.signal[6] = 1;
     if(data.bit(23) && !data.bit(24)) status.signal[7] = 0;
     if(data.bit(24) && !data.bit(23)) status.signal[7] = 1;
+
+    u32 after = 0;
+    for(u32 n : range(8)) after |= status.signal[n] << n;
+    if(after != signals) hostEvents.push(HostEvents::Signal, after);
   }
 
   if(address == 5) {
@@ -7,6 +7,7 @@ struct Writable {
     //memory::free<u8, 64_KiB>(data);
     //data = nullptr;
     size = 0;
+    dirty = 0;
     maskByte = 0;
     maskHalf = 0;
     maskWord = 0;
@@ -28,6 +29,25 @@ struct Writable {
     for(u32 address = 0; address < size; address += 4) {
       *(u32*)&data[address & maskWord] = value;
     }
+    dirty = ~0;
+    touch(~0);
+  }
+
+  auto serialize(serializer& s) -> void {
+    s(data);
+    if(s.mode() == serializer::Mode::Load) touch(~0);
+  }
+
+  //marks the 256-byte page containing address as modified (used for copy-on-write forks)
+  auto markDirty(u32 address) -> void {
+    u32 page = (address & maskByte) >> PageBits;
+    dirty |= 1 << page;
+    generation[page]++;
+  }
+
+  //for changes that bypass write(): anything derived from the contents of these pages is stale
+  auto touch(u32 pages) -> void {
+    for(u32 n = 0; n < Pages; n++) generation[n] += pages >> n & 1;
   }
 
 
@@ -46,6 +66,7 @@ struct Writable {
 
   template<u32 Size>
   auto write(u32 address, u64 value) -> void {
+    if constexpr(Size != Dual) markDirty(address);
     if constexpr(Size == Byte) *(u8* )&data[address & maskByte ^ 3] = value;
     if constexpr(Size == Half) *(u16*)&data[address & maskHalf ^ 2] = value;
     if constexpr(Size == Word) *(u32*)&data[address & maskWord ^ 0] = value;
@@ -95,7 +116,11 @@ struct Writable {
 
 
 //private:
+  enum : u32 { PageBits = 8, PageSize = 1 << PageBits, Pages = 1024 * 4 / PageSize };
+
   u8 data[1024 * 4]{};
+  u32 dirty = 0;
+  u32 generation[Pages]{};  //bumped on every change of a page, never reset
   u32 size = 0;
   u32 maskByte = 0;
   u32 maskHalf = 0;
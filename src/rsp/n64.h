@@ -16,8 +16,50 @@ enum : u32 { Read, Write };
 enum : u32 { Byte = 1, Half = 2, Word = 4, Dual = 8, DCache = 16, ICache = 32 };
 
 
+//VPU implementation: the SSE4.1 kernels on native builds that support them, the scalar loops otherwise.
+//defining RSP_VPU_SISD or RSP_VPU_SIMD forces one.
+//RSP_VPU_CROSSCHECK compiles both and runs every VU instruction through each, comparing the results (crosscheck.cpp).
+#if defined(RSP_VPU_CROSSCHECK)
+  #define RSP_VPU_SISD
+  #define RSP_VPU_SIMD
+#endif
+
+#if !defined(RSP_VPU_SISD) && !defined(RSP_VPU_SIMD)
+  #if ARCHITECTURE_SUPPORTS_SSE4_1
+    #define RSP_VPU_SIMD
+  #else
+    #define RSP_VPU_SISD
+  #endif
+#endif
+
+#if defined(RSP_VPU_SIMD) && !ARCHITECTURE_SUPPORTS_SSE4_1
+  #error "RSP_VPU_SIMD requires SSE4.1"
+#endif
+
+#if defined(RSP_VPU_SISD) && defined(RSP_VPU_SIMD) && !defined(RSP_VPU_CROSSCHECK)
+  #error "RSP_VPU_SISD and RSP_VPU_SIMD are exclusive, use RSP_VPU_CROSSCHECK to run both"
+#endif
+
 namespace Accuracy::RSP
 {
+#if defined(RSP_VPU_SISD)
   constexpr bool SISD = true;
-  constexpr bool SIMD = true;  
+#else
+  constexpr bool SISD = false;
+#endif
+#if defined(RSP_VPU_SIMD)
+  constexpr bool SIMD = true;
+#else
+  constexpr bool SIMD = false;
+#endif
+
+#if defined(RSP_VPU_CROSSCHECK)
+  //which of the two implementations the current pass runs
+  inline bool simdPass = false;
+  inline auto useSISD() -> bool { return !simdPass; }
+  inline auto useSIMD() -> bool { return simdPass; }
+#else
+  constexpr auto useSISD() -> bool { return SISD; }
+  constexpr auto useSIMD() -> bool { return SIMD; }
+#endif
 }
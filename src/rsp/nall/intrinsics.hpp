@@ -103,7 +103,11 @@ namespace nall {
 /* Architecture detection */
 
 #if !defined(ARCHITECTURE_SUPPORTS_SSE4_1)
-  #define ARCHITECTURE_SUPPORTS_SSE4_1 0
+  #if defined(__SSE4_1__)
+    #define ARCHITECTURE_SUPPORTS_SSE4_1 1
+  #else
+    #define ARCHITECTURE_SUPPORTS_SSE4_1 0
+  #endif
 #endif
 
 /* Endian detection */
@@ -0,0 +1,58 @@
+#pragma once
+
+namespace nall {
+
+//fixed-layout little-endian state serializer, operating on a caller-provided buffer
+struct serializer {
+  enum class Mode : u32 { Size, Save, Load };
+
+  serializer(Mode mode, u8* data = nullptr, u32 capacity = 0) : _mode(mode), _data(data), _capacity(capacity) {}
+
+  auto mode() const -> Mode { return _mode; }
+  auto size() const -> u32 { return _size; }
+  //false if the buffer was too small; the remaining data was skipped
+  auto valid() const -> bool { return _size <= _capacity || _mode == Mode::Size; }
+
+  template<typename T> auto operator()(T& value) -> serializer& {
+    if constexpr(requires { value.serialize(*this); }) {
+      value.serialize(*this);
+    } else if constexpr(requires { typename T::utype; }) {
+      typename T::utype data = value;
+      integer(data);
+      value = data;
+    } else {
+      integer(value);
+    }
+    return *this;
+  }
+
+  template<typename T, u32 Size> auto operator()(T (&array)[Size]) -> serializer& {
+    for(auto& value : array) operator()(value);
+    return *this;
+  }
+
+private:
+  template<typename T> auto integer(T& value) -> void {
+    enum : u32 { Size = sizeof(T) };
+    if(_mode != Mode::Size && _size + Size <= _capacity) {
+      if(_mode == Mode::Save) {
+        u64 data = value;
+        for(u32 n : range(Size)) _data[_size + n] = data >> n * 8;
+      } else {
+        u64 data = 0;
+        for(u32 n : range(Size)) data |= u64(_data[_size + n]) << n * 8;
+        value = T(data);
+      }
+    }
+    _size += Size;
+  }
+
+  Mode _mode;
+  u8* _data;
+  u32 _capacity;
+  u32 _size = 0;
+};
+
+}
+
+using nall::serializer;
@@ -0,0 +1,235 @@
+//log layout:
+//  header: "RSPR", version, varint state size
+//  groups: varint cycles since the previous group, then entries until GroupEnd or Stop
+//    Patch: varint words skipped since the previous patch, varint word count, little-endian words
+//    Stop:  FNV-1a hash of the final state, ends the log
+//  DMA reads: varint cycles since the previous group, DMARead, varint doubleword count, the row as little-endian words, GroupEnd.
+//    the row is fed back to the DMA engine on replay instead of reading RDRAM, so a log replays without the host's RDRAM.
+
+namespace {
+  constexpr u8 recorderMagic[] = {'R', 'S', 'P', 'R', Recorder::Version};
+}
+
+auto Recorder::start() -> void {
+  size = 0;
+  overflow = 0;
+  for(u8 byte : recorderMagic) writeByte(byte);
+  for(auto& byte : shadow) byte = 0;
+  stateSize = snapshot(live);
+  writeVarint(stateSize);
+
+  //the log starts from an all-zero state, so the first patch is the initial state itself
+  syncClock = 0;
+  leaveClock = 0;
+  recording = 1;
+  sync();
+  leaveClock = rsp.clock;
+}
+
+auto Recorder::stop() -> u32 {
+  if(!recording) return 0;
+  writeVarint(leaveClock - syncClock);
+  writeByte(Stop);
+  writeWord(hash(shadow));
+  recording = 0;
+  return overflow ? 0 : size;
+}
+
+auto Recorder::replay(u32 size) -> bool {
+  if(recording || size > Capacity) return false;
+  replaying = 1;
+  diverged = 0;
+  stagedCount = 0;
+  rsp.muted++;
+  bool result = replayLog(size);
+  rsp.muted--;
+  replaying = 0;
+  stagedCount = 0;
+  return result && !diverged;
+}
+
+auto Recorder::replayLog(u32 size) -> bool {
+  u32 offset = 0;
+  u8 byte;
+  u64 value;
+  for(u8 magic : recorderMagic) {
+    if(!readByte(offset, size, byte) || byte != magic) return false;
+  }
+  serializer sizer{serializer::Mode::Size};
+  rsp.serialize(sizer);
+  stateSize = sizer.size();
+  if(!readVarint(offset, size, value) || value != stateSize) return false;
+
+  for(auto& byte : live) byte = 0;
+  restore(live);
+  syncClock = 0;
+
+  while(true) {
+    if(!readVarint(offset, size, value)) return false;
+    s64 target = syncClock + value;
+    if(!readByte(offset, size, byte)) return false;
+
+    if(byte == DMARead) {
+      u64 count;
+      if(!readVarint(offset, size, count) || !count || count > 4096 / 8) return false;
+      if(offset + count * 8 > size) return false;
+      staged = offset;
+      stagedCount = count;
+      offset += count * 8;
+      while(rsp.clock < target) rsp.exec();
+      if(stagedCount || !readByte(offset, size, byte) || byte != GroupEnd) return false;
+      syncClock = rsp.clock;
+      continue;
+    }
+
+    while(rsp.clock < target) rsp.exec();
+    if(byte == Stop) {
+      u32 expected;
+      if(!readWord(offset, size, expected)) return false;
+      snapshot(live);
+      return hash(live) == expected;
+    }
+
+    snapshot(live);
+    u32 index = 0;
+    while(byte == Patch) {
+      u64 skip, count;
+      if(!readVarint(offset, size, skip) || !readVarint(offset, size, count)) return false;
+      index += skip;
+      if(index + count > StateCapacity / 4) return false;
+      for(u64 n = 0; n < count; n++) {
+        u32 word;
+        if(!readWord(offset, size, word)) return false;
+        __builtin_memcpy(&live[index++ * 4], &word, 4);
+      }
+      if(!readByte(offset, size, byte)) return false;
+    }
+    if(byte != GroupEnd) return false;
+    restore(live);
+    syncClock = rsp.clock;
+  }
+}
+
+auto Recorder::log(const u64* row, u32 count) -> void {
+  if(!recording) return;
+  writeVarint(rsp.clock - syncClock);
+  writeByte(DMARead);
+  writeVarint(count);
+  for(u32 n : range(count)) {
+    writeWord(row[n]);
+    writeWord(row[n] >> 32);
+  }
+  writeByte(GroupEnd);
+  syncClock = rsp.clock;
+}
+
+auto Recorder::feed(u64* row, u32 count) -> bool {
+  if(!replaying) return false;
+  if(stagedCount != count) {
+    for(u32 n : range(count)) row[n] = 0;
+    diverged = 1;
+    return true;
+  }
+  for(u32 n : range(count)) {
+    u32 offset = staged + n * 8, lo, hi;
+    readWord(offset, Capacity, lo);
+    readWord(offset, Capacity, hi);
+    row[n] = u64(hi) << 32 | lo;
+  }
+  stagedCount = 0;
+  return true;
+}
+
+auto Recorder::sync() -> void {
+  snapshot(live);
+  u32 words = (stateSize + 3) / 4;
+  u32 last = 0;
+  bool logged = false;
+  for(u32 index = 0; index < words;) {
+    auto differs = [&](u32 index) { return __builtin_memcmp(&live[index * 4], &shadow[index * 4], 4) != 0; };
+    if(!differs(index)) { index++; continue; }
+
+    u32 end = index + 1;
+    while(end < words && differs(end)) end++;
+    if(!logged) writeVarint(leaveClock - syncClock), logged = true;
+    writeByte(Patch);
+    writeVarint(index - last);
+    writeVarint(end - index);
+    for(; index < end; index++) {
+      u32 word;
+      __builtin_memcpy(&word, &live[index * 4], 4);
+      __builtin_memcpy(&shadow[index * 4], &word, 4);
+      writeWord(word);
+    }
+    last = end;
+  }
+  if(logged) {
+    writeByte(GroupEnd);
+    syncClock = rsp.clock;
+  }
+}
+
+auto Recorder::capture() -> void {
+  snapshot(shadow);
+  leaveClock = rsp.clock;
+}
+
+auto Recorder::snapshot(u8* target) -> u32 {
+  serializer s{serializer::Mode::Save, target, StateCapacity};
+  rsp.serialize(s);
+  return s.size();
+}
+
+auto Recorder::restore(u8* source) -> void {
+  serializer s{serializer::Mode::Load, source, StateCapacity};
+  rsp.serialize(s);
+  rsp.imem.dirty = ~0;
+  rsp.dmem.dirty = ~0;
+}
+
+auto Recorder::hash(const u8* source) const -> u32 {
+  u32 value = 0x811c9dc5;
+  for(u32 n : range(stateSize)) value = (value ^ source[n]) * 0x01000193;
+  return value;
+}
+
+auto Recorder::writeByte(u8 value) -> void {
+  if(size >= Capacity) { overflow = 1; return; }
+  data[size++] = value;
+}
+
+auto Recorder::writeWord(u32 value) -> void {
+  for(u32 n : range(4)) writeByte(value >> n * 8);
+}
+
+auto Recorder::writeVarint(u64 value) -> void {
+  while(value >= 0x80) writeByte(value | 0x80), value >>= 7;
+  writeByte(value);
+}
+
+auto Recorder::readByte(u32& offset, u32 limit, u8& value) const -> bool {
+  if(offset >= limit) return false;
+  value = data[offset++];
+  return true;
+}
+
+auto Recorder::readWord(u32& offset, u32 limit, u32& value) const -> bool {
+  value = 0;
+  for(u32 n : range(4)) {
+    u8 byte;
+    if(!readByte(offset, limit, byte)) return false;
+    value |= u32(byte) << n * 8;
+  }
+  return true;
+}
+
+auto Recorder::readVarint(u32& offset, u32 limit, u64& value) const -> bool {
+  value = 0;
+  for(u32 shift = 0; shift < 64; shift += 7) {
+    u8 byte;
+    if(!readByte(offset, limit, byte)) return false;
+    value |= u64(byte & 0x7f) << shift;
+    if(!(byte & 0x80)) return true;
+  }
+  return false;
+}
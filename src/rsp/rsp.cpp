@@ -1,6 +1,16 @@
+//system headers can't be included from within the namespace below
+#if defined(__SSE4_1__)
+  #include <immintrin.h>
+#endif
+
 namespace ares::N64 {
 #include "rsp.hpp"
 RSP rsp;
+Contexts contexts;
+Recorder recorder;
+RDRAM rdram;
+HostEvents hostEvents;
+Timeline timeline;
 
 namespace {
     const char* CMD_RSPQ[] = {
@@ -44,19 +54,30 @@ namespace {
 }
 
 #include "decoder.cpp"
+#include "scheduler.cpp"
 #include "dma.cpp"
 #include "io.cpp"
+#include "dpc.cpp"
 #include "interpreter.cpp"
 #include "interpreter-ipu.cpp"
 #include "interpreter-scc.cpp"
 #include "interpreter-vpu.cpp"
+#include "crosscheck.cpp"
 #include "serialization.cpp"
+#include "fork.cpp"
+#include "recorder.cpp"
+#include "timeline.cpp"
+#include "events.cpp"
+#include "timing.cpp"
 
 auto RSP::load() -> void {
   dmem.allocate(4 * 1024, 0);
   imem.allocate(4 * 1024, 0);
   ipu = {};
   vpu = {};
+  scheduler.reset();
+  dmaStats.reset();
+  rdpCapture.reset();
 }
 
 auto RSP::unload() -> void {
@@ -65,46 +86,115 @@ auto RSP::unload() -> void {
 }
 
 auto RSP::exec() -> void {
-  auto clock = Thread::clock;
-
   if(status.halted) {
     step(1);
   } else {
     instruction();
   }
 
-  dmaStep(Thread::clock - clock);
+  if(Thread::clock >= scheduler.next) serviceEvents();
 }
 
+//table index: timed << 6 | primary opcode
+template<u32 n> struct InstructionOp { static constexpr auto (RSP::*entry)(u32) -> s32 = &RSP::instruction<(n >> 6), (n & 63)>; };
+template<u32 n> struct ThreadedOp    { static constexpr RSP::Threaded entry = &RSP::threadedStep<(n >> 6), (n & 63)>; };
+static constexpr auto instructionTable = handlerTable<auto (RSP::*)(u32) -> s32, InstructionOp>(makeSequence<2 * 64>{});
+static constexpr auto threadedTable    = handlerTable<RSP::Threaded, ThreadedOp>(makeSequence<2 * 64>{});
+
 auto RSP::instruction() -> void {
-  {
-    u32 instruction = imem.read<Word>(ipu.pc);
+  u32 instruction = imem.read<Word>(ipu.pc);
+  (this->*instructionTable[!functional << 6 | instruction >> 26])(instruction);
+}
 
+//id is the primary opcode of 'instruction'.
+//returns non-zero if the RSP halted or a taken branch just finished its delay slot.
+template<bool Timed, u8 id>
+auto RSP::instruction(u32 instruction) -> s32 {
+  //functional tier: same architectural results, one instruction per step at a flat 3 clocks, no pipeline model
+  if constexpr(!Timed) {
     instructionPrologue(instruction);
+    interpreterEXECUTE<id>();
+    s32 boundary = instructionEpilogue<0>(0);
+    step(3);
+    return boundary;
+  }
+
+  instructionPrologue(instruction);
+  if(auto memo = timing.replay(*this, instruction)) {
+    interpreterEXECUTE<id>();
+    if(memo->paired) {
+      instructionEpilogue<0>(0);
+      instructionPrologue(memo->instruction[1]);
+      interpreterEXECUTE();
+    }
+    memo->out.restore(pipeline);
+    pipeline.clocks = memo->clocks;
+  } else {
     pipeline.begin();
     OpInfo op0 = decoderEXECUTE(instruction);
     pipeline.issue(op0);
-    interpreterEXECUTE();
+    interpreterEXECUTE<id>();
 
-    if(!pipeline.singleIssue && !op0.branch()) {
-      u32 instruction = imem.read<Word>(ipu.pc + 4);
-      OpInfo op1 = decoderEXECUTE(instruction);
+    u32 next = 0;
+    u1 lookahead = !pipeline.singleIssue && !op0.branch();
+    u1 paired = 0;
+    if(lookahead) {
+      next = imem.read<Word>(ipu.pc + 4);
+      OpInfo op1 = decoderEXECUTE(next);
 
       if(canDualIssue(op0, op1)) {
         instructionEpilogue<0>(0);
-        instructionPrologue(instruction);
+        instructionPrologue(next);
         pipeline.issue(op1);
         interpreterEXECUTE();
+        paired = 1;
       }
     }
 
     pipeline.end();
-    instructionEpilogue<0>(0);
+    timing.record(*this, instruction, next, lookahead, paired);
   }
+  s32 boundary = instructionEpilogue<0>(0);
 
   //this handles all stepping for the interpreter
   //with the recompiler, it only steps for taken branch stalls
   step(pipeline.clocks);
+  timing.advance(*this, boundary);
+  return boundary;
+}
+
+//a halted RSP only waits for events: jumps from one to the next (or to 'end') instead of ticking single clocks.
+//stops as soon as it's unhalted. same result as calling exec() in a loop.
+auto RSP::idle(s64 end) -> void {
+  while(status.halted && Thread::clock < end) {
+    Thread::clock = scheduler.next < end ? scheduler.next : end;
+    if(Thread::clock >= scheduler.next) serviceEvents();
+  }
+}
+
+//runs until the RSP halts or 'end' is reached. same result as calling exec() in a loop.
+auto RSP::run(s64 end) -> void {
+  scheduler.schedule(Scheduler::Stop, end);
+  while(Thread::clock < end && !status.halted) {
+    u32 instruction = imem.read<Word>(ipu.pc);
+    threadedTable[!functional << 6 | instruction >> 26](*this, instruction);
+    if(Thread::clock >= scheduler.next) serviceEvents();
+  }
+  scheduler.cancel(Scheduler::Stop);
+}
+
+//every step tail-calls the handler of the next instruction, the chain only returns to run() at a block boundary,
+//once the next event (or the end of the slice) is due, or when the PC wraps (which bounds the stack should the tail call not be guaranteed).
+template<bool Timed, u8 id>
+auto RSP::threadedStep(RSP& self, u32 instruction) -> void {
+  s32 boundary = self.instruction<Timed, id>(instruction);
+  if(boundary || self.clock >= self.scheduler.next || !self.ipu.pc) return;
+
+  instruction = self.imem.read<Word>(self.ipu.pc);
+#if __has_cpp_attribute(clang::musttail)
+  [[clang::musttail]]
+#endif
+  return threadedTable[Timed << 6 | instruction >> 26](self, instruction);
 }
 
 auto RSP::instructionPrologue(u32 instruction) -> void {
@@ -140,7 +230,10 @@ auto RSP::power(bool reset) -> void {
   imem.fill();
 
   pipeline = {};
+  timing.reset();
+  scheduler.reset();
   dma = {};
+  dmaStats.reset();
   status.semaphore = 0;
   status.halted = 1;
   status.broken = 0;
@@ -148,6 +241,8 @@ auto RSP::power(bool reset) -> void {
   status.singleStep = 0;
   status.interruptOnBreak = 0;
   for(auto& signal : status.signal) signal = 0;
+  dpc.command = {};
+  rdpCapture.reset();
   for(auto& r : ipu.r) r.u32 = 0;
   ipu.pc = 0;
   branch = {};
@@ -155,6 +250,7 @@ auto RSP::power(bool reset) -> void {
   vpu.acch = zero;
   vpu.accm = zero;
   vpu.accl = zero;
+  vpu.wide = 0;
   vpu.vcoh = zero;
   vpu.vcol = zero;
   vpu.vcch = zero;
@@ -163,21 +259,6 @@ auto RSP::power(bool reset) -> void {
   vpu.divin = 0;
   vpu.divout = 0;
   vpu.divdp = 0;
-
-  reciprocals[0] = u16(~0);
-  for(u16 index : range(1, 512)) {
-    u64 a = index + 512;
-    u64 b = (u64(1) << 34) / a;
-    reciprocals[index] = u16(b + 1 >> 8);
-  }
-
-  for(u16 index : range(0, 512)) {
-    u64 a = index + 512 >> (index % 2 == 1);
-    u64 b = 1 << 17;
-    //find the largest b where b < 1.0 / sqrt(a)
-    while(a * (b + 1) * (b + 1) < (u64(1) << 44)) b++;
-    inverseSquareRoots[index] = u16(b >> 1);
-  }
 }
 
 }
@@ -1,6 +1,4 @@
 //Reality Signal Processor
-#include "n64.h"
-
 #include "nall/bit-range.hpp"
 #include "nall/intrinsics.hpp"
 #include "nall/endian.hpp"
@@ -9,6 +7,8 @@
 #include "nall/real.hpp"
 #include "nall/integer.hpp"
 #include "nall/types.hpp"
+#include "nall/serializer.hpp"
+#include "n64.h"
 #include "memory/memory.hpp"
 
 struct RSP : Thread, Memory::RCP<RSP> {
@@ -49,11 +49,25 @@ struct RSP : Thread, Memory::RCP<RSP> {
   auto exec() -> void;
 
   auto instruction() -> void;
+  template<bool Timed, u8 id> auto instruction(u32 instruction) -> s32;
+  auto run(s64 end) -> void;
+  auto idle(s64 end) -> void;
+  using Threaded = auto (*)(RSP& self, u32 instruction) -> void;
+  template<bool Timed, u8 id> static auto threadedStep(RSP& self, u32 instruction) -> void;
+
+  //skips the pipeline model (stalls, dual issue), architectural results are unchanged
+  bool functional = 0;
+
+  //re-executions (replay, stepping back) leave what the host has seen alone: dmaStats, rdpCapture and hostEvents
+  u32 muted = 0;
   auto instructionPrologue(u32 instruction) -> void;
   template<bool Recompiled> auto instructionEpilogue(u32 clocks) -> s32;
 
   auto power(bool reset) -> void;
 
+  //serialization.cpp
+  auto serialize(serializer&) -> void;
+
   struct OpInfo {
     enum : u32 {
       Load      = 1 << 0,
@@ -92,17 +106,24 @@ struct RSP : Thread, Memory::RCP<RSP> {
     u32 clocks;
     u1 singleIssue;
 
-    struct Stage {
-      u1 load;
-      u32 rWrite;
-      u32 vWrite;
-    } previous[3];
+    //hazards of the previous stages as thermometer masks: pending[n] holds the registers
+    //a read would still have to wait for more than n stalls on. a stall moves every level down by one.
+    struct History {
+      u32 rPending[2];  //GPRs written one or two stages back
+      u32 vPending[3];  //VRs written up to three stages back
+      u8  loads;        //bit 0: the last stage issued a load, bit 1: the one before
+
+      auto operator==(const History&) const -> bool = default;
+    } history;
 
-    struct : Stage {
+    struct {
+      u1 load;
       u1 store;
       u1 branch;
       u32 rRead;
+      u32 rWrite;
       u32 vRead;
+      u32 vWrite;
     } current;
 
 
@@ -111,23 +132,28 @@ struct RSP : Thread, Memory::RCP<RSP> {
     }
 
     auto end() -> void {
-      readGPR(current.rRead);
-      readVR(current.vRead);
-      if(current.store) store();
+      //stall depth is the number of levels a read still hits: GPR and VR stalls overlap,
+      //stores then wait for loads that were issued one stage back
+      u32 stalls = max(levels(current.rRead, history.rPending), levels(current.vRead, history.vPending));
+      if(current.store) {
+        u32 loads = history.loads << stalls & 3;
+        stalls += (loads >> 1) + (loads == 3);
+      }
+      shift(stalls);
       singleIssue = current.branch;
 
-      previous[2] = previous[1];
-      previous[1] = previous[0];
-      previous[0] = current;
+      history.rPending[0] = history.rPending[1] | current.rWrite;
+      history.rPending[1] = current.rWrite;
+      history.vPending[0] = history.vPending[1] | current.vWrite;
+      history.vPending[1] = history.vPending[2] | current.vWrite;
+      history.vPending[2] = current.vWrite;
+      history.loads = (history.loads << 1 | current.load) & 3;
       current = {};
       clocks += 3;
     }
 
     auto stall() -> void {
-      previous[2] = previous[1];
-      previous[1] = previous[0];
-      previous[0] = {};
-      clocks += 3;
+      shift(1);
     }
 
     auto issue(const OpInfo& op) -> void {
@@ -141,36 +167,111 @@ struct RSP : Thread, Memory::RCP<RSP> {
     }
 
   private:
-    auto readGPR(u32 mask) -> Pipeline& {
-      if(mask & previous[0].rWrite) {
-        stall(), stall();
-      } else if(mask & previous[1].rWrite) {
-        stall();
-      }
-      return *this;
-    }
-
-    auto readVR(u32 mask) -> Pipeline& {
-      if(mask & previous[0].vWrite) {
-        stall(), stall(), stall();
-      } else if(mask & previous[1].vWrite) {
-        stall(), stall();
-      } else if(mask & previous[2].vWrite) {
-        stall();
-      }
-      return *this;
+    //levels are nested, so the first one missed is the depth
+    template<u32 Size>
+    static auto levels(u32 mask, const u32 (&pending)[Size]) -> u32 {
+      u32 missed = 1 << Size;
+      for(u32 n : range(Size)) missed |= !(mask & pending[n]) << n;
+      return __builtin_ctz(missed);
     }
 
-    auto store() -> void {
-      while(previous[1].load) {
-        stall();
-      }
+    auto shift(u32 stalls) -> void {
+      if(!stalls) return;
+      auto& h = history;
+      h.rPending[0] = stalls < 2 ? h.rPending[stalls] : 0;
+      h.rPending[1] = 0;
+      h.vPending[0] = stalls < 3 ? h.vPending[stalls] : 0;
+      h.vPending[1] = stalls < 2 ? h.vPending[stalls + 1] : 0;
+      h.vPending[2] = 0;
+      h.loads = h.loads << stalls & 3;
+      clocks += 3 * stalls;
     }
   } pipeline;
 
+  //timing.cpp
+  //the pipeline model only depends on the instruction words and the incoming hazards,
+  //so each straight-line run (up to a branch delay slot) is recorded once per entry PC and hazard state.
+  //later executions replay the pairing decisions and clocks instead of decoding and stalling again.
+  //blocks are found by PC, incoming hazards and a hash of the code they cover, and evicted least recently used.
+  //so they survive overlays being swapped out and back in. the hash is cached per PC until one of its IMEM pages changes.
+  struct Timing {
+    enum : u32 { Sets = 256, Ways = 4, Steps = 16, Window = Steps + 1 };
+
+    struct Hazards {
+      Pipeline::History history;
+      u1 singleIssue;
+
+      auto capture(const Pipeline& pipeline) -> void;
+      auto restore(Pipeline& pipeline) const -> void;
+      auto matches(const Pipeline& pipeline) const -> bool;
+    };
+
+    struct Step {
+      u32 instruction[2];
+      u1 lookahead;  //instruction[1] was decoded for dual issue
+      u1 paired;
+      u32 clocks;
+      Hazards out;   //before the epilogue, which handles taken branches
+    };
+
+    struct Block {
+      u32 code;  //hash of the 'Window' instruction words it was recorded from
+      u32 size;
+      u64 used;
+      Hazards in;
+      Step steps[Steps];
+    };
+
+    struct Code {
+      u32 hash;
+      u32 generation[2];  //of the IMEM pages the window spans
+    };
+
+    auto reset() -> void { block = nullptr; }
+    auto replay(RSP& self, u32 instruction) -> const Step*;
+    auto record(RSP& self, u32 instruction, u32 next, u1 lookahead, u1 paired) -> void;
+    auto advance(RSP& self, s32 boundary) -> void;
+
+  private:
+    static auto index(u32 code, const Pipeline& pipeline) -> u32;
+    auto code(RSP& self, u32 address) -> u32;
+    auto find(RSP& self) -> void;
+
+    Block blocks[Sets][Ways];
+    Code codes[4096 / 4];
+    u64 uses;
+    Block* block = nullptr;
+    u32 cursor;
+    u1 recording;
+    u32 address;  //PC and clock the next step of 'block' expects, anything else ends it
+    s64 clock;
+  } timing;
+
+  //scheduler.cpp
+  //device events as absolute clock timestamps: execution runs up to the earliest one
+  //instead of polling every device after each instruction.
+  struct Scheduler {
+    enum Event : u32 {
+      Stop,  //end of the current run() slice
+      DMA,
+      Events,
+    };
+    static constexpr s64 Never = 0x7fff'ffff'ffff'ffff;
+
+    auto reset() -> void;
+    auto schedule(Event event, s64 clock) -> void;
+    auto cancel(Event event) -> void;
+    auto update() -> void;
+
+    s64 at[Events] = {Never, Never};
+    s64 next = Never;  //earliest of 'at'
+  } scheduler;
+
+  auto serviceEvents() -> void;
+
   //dma.cpp
   auto dmaQueue(u32 clocks, Thread& thread) -> void;
-  auto dmaStep(u32 clocks) -> void;
+  auto dmaPoll(u32 kind, u1 pending) -> void;
   auto dmaTransferStart(Thread& thread) -> void;
   auto dmaTransferStep() -> void;
 
@@ -189,6 +290,9 @@ struct RSP : Thread, Memory::RCP<RSP> {
       n12 length;
       n12 skip;
       n8  count;
+
+      //serialization.cpp
+      auto serialize(serializer&) -> void;
     } pending, current;
 
     struct Status {
@@ -197,10 +301,41 @@ struct RSP : Thread, Memory::RCP<RSP> {
 
       auto any() -> n1 { return read | write; }
     } busy, full;
-
-    s64 clock;
   } dma;
 
+  //profiling only, not part of the state: a log of the transfers and the time spent polling for them.
+  //layout is read as-is by the JS side (rspjs.js).
+  struct DMAStats {
+    enum : u32 { Capacity = 256 };
+    enum : u32 { Busy, Full };
+
+    struct Transfer {
+      s64 queued;  //SP_READ_LENGTH/SP_WRITE_LENGTH written
+      s64 start;   //first row started
+      s64 end;     //last row landed, 0 while in flight
+      u32 dramAddress;
+      u32 pbusAddress;  //bit 12: IMEM
+      u32 length;       //bytes per row
+      u32 rows;
+      u32 skip;
+      u32 write;
+    };
+
+    auto reset() -> void;
+
+    s64 wait[2];  //clocks spent spinning on SP_DMA_BUSY/SP_DMA_FULL
+    u32 count;    //transfers started, the log keeps the last 'Capacity'
+    u32 reserved;
+    Transfer log[Capacity];
+
+    s64 queued;
+    struct Poll {
+      u32 pc;
+      s64 clock;
+      u1 pending;
+    } polls[2];
+  } dmaStats;
+
   struct Status : Memory::RCP<Status> {
     RSP& self;
     Status(RSP& self) : self(self) {}
@@ -218,6 +353,53 @@ struct RSP : Thread, Memory::RCP<RSP> {
     n1 signal[8];
   } status{*this};
 
+  //the RDP's command registers (DPC_*) as seen through COP0 $c8-$c15.
+  //the RDP itself isn't emulated: it takes every submission at once and the words end up in 'rdpCapture'.
+  struct DPC : Memory::RCP<DPC> {
+    RSP& self;
+    DPC(RSP& self) : self(self) {}
+
+    //dpc.cpp
+    auto readWord(u32 address, Thread& thread) -> u32;
+    auto writeWord(u32 address, u32 data, Thread& thread) -> void;
+    auto submit(Thread& thread) -> void;
+
+    struct Command {
+      //serialization.cpp
+      auto serialize(serializer&) -> void;
+
+      n24 start;
+      n24 end;
+      n24 current;
+      n1  source;  //0 = RDRAM, 1 = DMEM (XBUS)
+      n1  freeze;
+      n1  flush;
+      n1  startValid;
+      n1  endValid;
+    } command;
+  } dpc{*this};
+
+  //output only, not part of the state: every submitted command word and the cycle it was submitted at.
+  //the host drains it (see 'rsp_rdp_capture_reset'), layout is read as-is by the JS side (rspjs.js).
+  struct RDPCapture {
+    enum : u32 { Capacity = 256 * 1024, Submissions = 16 * 1024 };
+
+    struct Submission {
+      s64 clock;
+      u32 offset;  //first word in 'commands'
+      u32 count;   //in 64-bit words
+    };
+
+    auto reset() -> void;
+
+    u32 size;         //words in 'commands'
+    u32 submissionCount;
+    u32 overflow;     //submissions dropped since the last reset
+    u32 reserved;
+    Submission submissions[Submissions];
+    u64 commands[Capacity];
+  } rdpCapture;
+
   //ipu.cpp
   union r32 {
     struct {  int32_t s32; };
@@ -302,51 +484,86 @@ struct RSP : Thread, Memory::RCP<RSP> {
   //vpu.cpp: Vector Processing Unit
   union r128 {
     struct { u64 order_msb2(hi, lo); } u128;
+#if ARCHITECTURE_SUPPORTS_SSE4_1
+    __m128i v128;
+
+    operator __m128i() const { return v128; }
+    auto operator=(__m128i value) -> r128& { v128 = value; return *this; }
+#endif
+
+    //16-bit views of the 64-bit halves, may_alias keeps the optimizer from reordering them against u128 accesses
+    using lane  = uint16_t __attribute__((may_alias));
+    using slane =  int16_t __attribute__((may_alias));
 
     auto byte(u32 index) -> uint8_t& { return ((uint8_t*)&u128)[15 - index]; }
     auto byte(u32 index) const -> uint8_t { return ((uint8_t*)&u128)[15 - index]; }
 
-    auto element(u32 index) -> uint16_t& { return ((uint16_t*)&u128)[7 - index]; }
-    auto element(u32 index) const -> uint16_t { return ((uint16_t*)&u128)[7 - index]; }
+    auto element(u32 index) -> lane& { return ((lane*)&u128)[7 - index]; }
+    auto element(u32 index) const -> uint16_t { return ((const lane*)&u128)[7 - index]; }
 
     auto u8(u32 index) -> uint8_t& { return ((uint8_t*)&u128)[15 - index]; }
     auto u8(u32 index) const -> uint8_t { return ((uint8_t*)&u128)[15 - index]; }
 
-    auto s16(u32 index) -> int16_t& { return ((int16_t*)&u128)[7 - index]; }
-    auto s16(u32 index) const -> int16_t { return ((int16_t*)&u128)[7 - index]; }
+    auto s16(u32 index) -> slane& { return ((slane*)&u128)[7 - index]; }
+    auto s16(u32 index) const -> int16_t { return ((const slane*)&u128)[7 - index]; }
 
-    auto u16(u32 index) -> uint16_t& { return ((uint16_t*)&u128)[7 - index]; }
-    auto u16(u32 index) const -> uint16_t { return ((uint16_t*)&u128)[7 - index]; }
+    auto u16(u32 index) -> lane& { return ((lane*)&u128)[7 - index]; }
+    auto u16(u32 index) const -> uint16_t { return ((const lane*)&u128)[7 - index]; }
 
-    //VCx registers
-    auto get(u32 index) const -> bool { return u16(index) != 0; }
-    auto set(u32 index, bool value) -> bool { return u16(index) = 0 - value, value; }
-
-    //vu-registers.cpp
-    auto operator()(u32 index) const -> r128;
+    //interpreter-vpu.cpp: element selector broadcast
+    template<uint8_t e> auto broadcast() const -> r128;
 
     //serialization.cpp
-    // auto serialize(serializer&) -> void;
+    auto serialize(serializer&) -> void;
   };
   using cr128 = const r128;
 
+  //VCx registers: one bit per element, expanded to 0x0000/0xffff lanes only where a SIMD kernel needs them
+  struct r8 {
+    uint8_t bits;
+
+    auto get(u32 index) const -> bool { return bits >> index & 1; }
+    auto set(u32 index, bool value) -> bool { return bits = bits & ~(1 << index) | value << index, value; }
+
+    //interpreter-vpu.cpp
+    auto lanes() const -> r128;
+    auto operator=(cr128& lanes) -> r8&;
+#if ARCHITECTURE_SUPPORTS_SSE4_1
+    operator __m128i() const { return lanes(); }
+    auto operator=(__m128i lanes) -> r8& { r128 v; v = lanes; return *this = v; }
+#endif
+
+    //serialization.cpp
+    auto serialize(serializer&) -> void;
+  };
+
   struct VU {
     r128 r[32];
     r128 acch, accm, accl;
-    r128 vcoh, vcol;  //16-bit little endian
-    r128 vcch, vccl;  //16-bit little endian
-    r128 vce;         // 8-bit little endian
+      r8 vcoh, vcol;
+      r8 vcch, vccl;
+      r8 vce;
      s16 divin;
      s16 divout;
     bool divdp;
+     u32 acclo[8];    //48-bit accumulator per lane (bits 0-31 and 32-47),
+     s32 acchi[8];    //replaces acch/accm/accl while 'wide' is set
+    bool wide;
   } vpu;
 
   static constexpr r128 zero{0ull, 0ull};
   static constexpr r128 invert{~0ull, ~0ull};
 
-  auto accumulatorGet(u32 index) const -> u64;
-  auto accumulatorSet(u32 index, u64 value) -> void;
-  auto accumulatorSaturate(u32 index, bool slice, u16 negative, u16 positive) const -> u16;
+  //half of the wide accumulator as vectors, element 4 * half + n in lane n; only the low 16 bits of 'hi' count
+  using s32x4 = s32 __attribute__((vector_size(16)));
+  using u32x4 = u32 __attribute__((vector_size(16)));
+  struct Accumulator { u32x4 lo; s32x4 hi; };
+
+  auto accumulatorWiden() -> void;
+  auto accumulatorFlush() -> void;
+  auto accumulatorGet(u32 half) const -> Accumulator;
+  auto accumulatorSet(u32 half, const Accumulator& value) -> void;
+  auto accumulatorSaturate(bool slice, u16 negative, u16 positive) const -> r128;
 
   auto CFC2(r32& rt, u8 rd) -> void;
   auto CTC2(cr32& rt, u8 rd) -> void;
@@ -432,9 +649,53 @@ struct RSP : Thread, Memory::RCP<RSP> {
   template<u8 e> auto VXOR(r128& rd, cr128& vs, cr128& vt) -> void;
   template<u8 e> auto VZERO(r128& rd, cr128& vs, cr128& vt) -> void;
 
-//unserialized:
-  u16 reciprocals[512];
-  u16 inverseSquareRoots[512];
+#if defined(RSP_VPU_CROSSCHECK)
+  //crosscheck.cpp
+  struct CrossCheck {
+    u1  active;
+    u32 checked;
+    u32 diverged;
+    struct {
+      u32 instruction;  //element selector in bits 21-24
+      u32 position;     //index of the instruction in a crossCheckSequence() run
+      VU input;
+      VU sisd;
+      VU simd;
+    } first;
+  } crossCheck;
+
+  auto crossCheckVU() -> void;
+  auto crossCheckRandom(u32 count, u32 seed) -> u32;
+  auto crossCheckSequence(u32 count, u32 length, u32 seed) -> u32;
+  auto crossCheckTranspose(u32 count, u32 seed) -> u32;
+  auto crossCheckDivide(u32 samples, u32 seed) -> u32;
+  auto crossCheckPipeline(u32 count, u32 seed) -> u32;
+#endif
+
+  //fork.cpp: everything except memory, which is shared copy-on-write between contexts
+  struct State {
+    s64 clock;
+    bool functional;
+    Pipeline pipeline;
+    Scheduler scheduler;
+    DMA dma;
+    struct {
+      n1 semaphore;
+      n1 halted;
+      n1 broken;
+      n1 full;
+      n1 singleStep;
+      n1 interruptOnBreak;
+      n1 signal[8];
+    } status;
+    DPC::Command dpc;
+    IPU ipu;
+    Branch branch;
+    VU vpu;
+  };
+
+  auto saveState(State& state) const -> void;
+  auto loadState(const State& state) -> void;
 
   //decoder.cpp
   auto decoderEXECUTE(u32 instruction) const -> OpInfo;
@@ -447,14 +708,207 @@ struct RSP : Thread, Memory::RCP<RSP> {
 
   //interpreter.cpp
   auto interpreterEXECUTE() -> void;
+  template<u8 id> auto interpreterEXECUTE() -> void;
   auto interpreterSPECIAL() -> void;
   auto interpreterREGIMM() -> void;
   auto interpreterSCC() -> void;
   auto interpreterVU() -> void;
   auto interpreterLWC2() -> void;
   auto interpreterSWC2() -> void;
+  using Handler = auto (RSP::*)() -> void;
+  template<u8 id, u8 e> auto interpreterVUTransfer() -> void;
+  template<u8 id, u8 e> auto interpreterVUCompute() -> void;
+  template<u8 id, u8 e> auto interpreterLWC2() -> void;
+  template<u8 id, u8 e> auto interpreterSWC2() -> void;
 
   auto INVALID() -> void;
 };
 
 extern RSP rsp;
+
+//RDRAM as seen by the DMA engine: plain big-endian bytes owned by the host (see 'rsp_ptr_rdram').
+//it is not part of contexts, checkpoints or the serialized state.
+struct RDRAM {
+  enum : u32 { Size = 8 * 1024 * 1024 };
+
+  auto read(u32 address) const -> u64;
+  auto write(u32 address, u64 data) -> void;
+
+  u8 data[Size];
+};
+
+extern RDRAM rdram;
+
+struct Contexts {
+  enum : u32 {
+    PageSize = Memory::Writable::PageSize,
+    Pages = 4096 / PageSize,
+    PoolPages = 4096,
+    MaxContexts = 256,
+    Invalid = ~0u,
+  };
+
+  struct Context {
+    u1 used;
+    RSP::State state;
+    u16 imem[Pages];
+    u16 dmem[Pages];
+  };
+
+  auto reset() -> void;
+  auto fork(u32 handle) -> u32;
+  auto select(u32 handle) -> bool;
+  auto free(u32 handle) -> bool;
+  auto revert(u32 handle) -> bool;
+
+  u32 current;
+
+private:
+  auto allocate() -> u32;
+  auto release(u16 page) -> void;
+  auto commit() -> bool;
+  auto commitPages(Memory::Writable& memory, u16* pages) -> void;
+  auto loadPages(Memory::Writable& memory, const u16* pages, const u16* previous) -> void;
+  auto sharePages(Memory::Writable& memory, u16* pages, const u16* source) -> void;
+  auto pagesNeeded(const Memory::Writable& memory, const u16* pages) const -> u32;
+
+  u8  pool[PoolPages][PageSize];
+  u32 refs[PoolPages];
+  u32 freePages;
+  Context contexts[MaxContexts];
+};
+
+extern Contexts contexts;
+
+//the RSP is deterministic: everything that can change its outcome comes from the host in-between runs.
+//recording diffs the serialized state at the start of each run against where the last run stopped,
+//and logs only the changed words together with the cycle they were applied at.
+struct Recorder {
+  enum : u32 {
+    Capacity = 1 << 20,
+    StateCapacity = 16 * 1024,
+    Version = 7,
+  };
+
+  enum : u8 { GroupEnd, Patch, Stop, DMARead };
+
+  auto start() -> void;
+  auto stop() -> u32;
+  auto replay(u32 size) -> bool;
+
+  //rows read from RDRAM are inputs too: logged while recording, and fed back from the log on replay
+  auto log(const u64* row, u32 count) -> void;
+  auto feed(u64* row, u32 count) -> bool;
+
+  auto enter() -> void { if(recording) sync(); }
+  auto leave() -> void { if(recording) capture(); }
+
+  u1 recording;
+  u1 overflow;
+  u32 size;
+  u8 data[Capacity];
+
+private:
+  auto replayLog(u32 size) -> bool;
+  auto sync() -> void;
+  auto capture() -> void;
+  auto snapshot(u8* target) -> u32;
+  auto restore(u8* source) -> void;
+  auto hash(const u8* source) const -> u32;
+
+  auto writeByte(u8 value) -> void;
+  auto writeWord(u32 value) -> void;
+  auto writeVarint(u64 value) -> void;
+  auto readByte(u32& offset, u32 limit, u8& value) const -> bool;
+  auto readWord(u32& offset, u32 limit, u32& value) const -> bool;
+  auto readVarint(u32& offset, u32 limit, u64& value) const -> bool;
+
+  u8  shadow[StateCapacity];
+  u8  live[StateCapacity];
+  u32 stateSize;
+  s64 syncClock;   //clock right after the last logged group
+  s64 leaveClock;  //clock at the end of the last run
+
+  u1  replaying;
+  u1  diverged;     //a DMA read found no matching row in the log
+  u32 staged;       //offset of the logged row the next DMA read is fed from
+  u32 stagedCount;  //its size in doublewords, 0 if none
+};
+
+extern Recorder recorder;
+
+//reverse stepping: checkpoints are forked contexts, taken every 'interval' cycles and whenever
+//the host regains control (as it may have changed anything). stepping back reverts to the
+//closest checkpoint and re-executes the remaining instructions.
+//RDRAM isn't checkpointed, so re-executing a DMA row could see or overwrite later data: stepping
+//back is refused if the checkpoint predates the last row that moved.
+struct Timeline {
+  enum : u32 { MaxCheckpoints = 128 };
+
+  struct Checkpoint {
+    u32 handle;
+    u64 steps;
+  };
+
+  auto enable(u32 interval) -> void;
+  auto reset() -> void;
+  auto stepBack(u64 distance) -> bool;
+
+  auto active() const -> bool { return interval; }
+  auto enter() -> void { if(interval) checkpoint(); }
+  auto step() -> void {
+    if(!interval) return;
+    if(rsp.clock >= nextClock) checkpoint();
+    steps++;
+  }
+  auto transfer() -> void { transferSteps = steps; }
+
+  u64 steps;
+  u64 transferSteps;  //step during which the last DMA row moved
+
+private:
+  auto checkpoint() -> void;
+  auto dropOldest() -> void;
+  auto dropNewest() -> void;
+
+  Checkpoint ring[MaxCheckpoints];
+  u32 first;
+  u32 count;
+  u32 owner;
+  u32 interval;
+  s64 nextClock;
+};
+
+extern Timeline timeline;
+
+//what the host may want to react to: BREAK, the SP interrupt line and the signal bits.
+//events are queued with their cycle for the host to drain after a run, kinds set in 'immediate'
+//are also passed on right away through 'callback' (a function table slot in WASM).
+struct HostEvents {
+  enum : u32 { Capacity = 1024 };
+  enum Kind : u32 {
+    Break,      //data: PC of the BREAK
+    Interrupt,  //data: 1 raised, 0 lowered
+    Signal,     //data: SP_STATUS signal bits 0-7 after the change
+  };
+
+  struct Event {
+    s64 clock;
+    u32 kind;
+    u32 data;
+  };
+
+  auto reset() -> void;
+  auto push(Kind kind, u32 data) -> void;
+
+  u32 count;
+  u32 overflow;   //events dropped since the queue was full
+  u32 immediate;  //bitmask of kinds
+  u32 reserved;
+  Event queue[Capacity];
+
+  using Callback = void (*)(u32 kind, u32 data);
+  Callback callback;
+};
+
+extern HostEvents hostEvents;
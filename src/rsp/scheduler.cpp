@@ -0,0 +1,36 @@
+auto RSP::Scheduler::reset() -> void {
+  for(auto& clock : at) clock = Never;
+  next = Never;
+}
+
+auto RSP::Scheduler::schedule(Event event, s64 clock) -> void {
+  at[event] = clock;
+  update();
+}
+
+auto RSP::Scheduler::cancel(Event event) -> void {
+  at[event] = Never;
+  update();
+}
+
+auto RSP::Scheduler::update() -> void {
+  next = Never;
+  for(auto clock : at) next = min(next, clock);
+}
+
+//runs every event that is due, in timestamp order (ties go to the lower event number).
+//handlers may schedule again, an event due right away is run within the same call.
+auto RSP::serviceEvents() -> void {
+  while(Thread::clock >= scheduler.next) {
+    u32 event = 0;
+    for(u32 n : range(Scheduler::Events)) {
+      if(scheduler.at[n] < scheduler.at[event]) event = n;
+    }
+    scheduler.cancel((Scheduler::Event)event);
+
+    switch(event) {
+    case Scheduler::Stop: break;  //only ends the threaded chain
+    case Scheduler::DMA: dmaTransferStep(); break;
+    }
+  }
+}
@@ -1,17 +1,17 @@
-/*
 auto RSP::serialize(serializer& s) -> void {
-  Thread::serialize(s);
+  accumulatorFlush();
+  s(Thread::clock);
+  s(functional);
   s(dmem);
   s(imem);
 
   s(pipeline.address);
   s(pipeline.instruction);
   s(pipeline.singleIssue);
-  for(auto& p : pipeline.previous) {
-    s(p.load);
-    s(p.rWrite);
-    s(p.vWrite);
-  }
+  s(pipeline.history.rPending);
+  s(pipeline.history.vPending);
+  s(pipeline.history.loads);
+  if(s.mode() == serializer::Mode::Load) timing.reset();
 
   s(dma.pending);
   s(dma.current);
@@ -19,7 +19,8 @@ auto RSP::serialize(serializer& s) -> void {
   s(dma.busy.write);
   s(dma.full.read);
   s(dma.full.write);
-  s(dma.clock);
+  s(scheduler.at);
+  if(s.mode() == serializer::Mode::Load) scheduler.update();
 
   s(status.semaphore);
   s(status.halted);
@@ -29,6 +30,8 @@ auto RSP::serialize(serializer& s) -> void {
   s(status.interruptOnBreak);
   s(status.signal);
 
+  s(dpc.command);
+
   for(auto& r : ipu.r) s(r.u32);
   s(ipu.pc);
 
@@ -58,8 +61,22 @@ auto RSP::DMA::Regs::serialize(serializer& s) -> void {
   s(count);
 }
 
+auto RSP::DPC::Command::serialize(serializer& s) -> void {
+  s(start);
+  s(end);
+  s(current);
+  s(source);
+  s(freeze);
+  s(flush);
+  s(startValid);
+  s(endValid);
+}
+
 auto RSP::r128::serialize(serializer& s) -> void {
   s(u128.lo);
   s(u128.hi);
 }
-*/
\ No newline at end of file
+
+auto RSP::r8::serialize(serializer& s) -> void {
+  s(bits);
+}
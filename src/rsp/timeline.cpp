@@ -0,0 +1,65 @@
+//interval is in cycles, 0 disables the timeline
+auto Timeline::enable(u32 interval) -> void {
+  reset();
+  this->interval = interval;
+}
+
+auto Timeline::reset() -> void {
+  while(count) dropOldest();
+  first = 0;
+  steps = 0;
+  transferSteps = 0;
+  owner = contexts.current;
+  nextClock = rsp.clock;
+}
+
+auto Timeline::stepBack(u64 distance) -> bool {
+  if(!interval || distance > steps || owner != contexts.current) return false;
+  u64 target = steps - distance;
+
+  if(!count || ring[first].steps > target) return false;
+  u32 newest = count;
+  while(ring[(first + newest - 1) % MaxCheckpoints].steps > target) newest--;
+  if(ring[(first + newest - 1) % MaxCheckpoints].steps < transferSteps) return false;
+  while(count > newest) dropNewest();
+
+  auto& checkpoint = ring[(first + count - 1) % MaxCheckpoints];
+  if(!contexts.revert(checkpoint.handle)) return false;
+  steps = checkpoint.steps;
+  nextClock = rsp.clock + interval;
+
+  rsp.muted++;
+  while(steps < target) {
+    step();
+    rsp.exec();
+  }
+  rsp.muted--;
+  return true;
+}
+
+auto Timeline::checkpoint() -> void {
+  //checkpoints are only meaningful for the context they were forked from
+  if(owner != contexts.current) {
+    reset();
+  }
+  if(count && ring[(first + count - 1) % MaxCheckpoints].steps == steps) dropNewest();
+  if(count == MaxCheckpoints) dropOldest();
+
+  u32 handle;
+  while((handle = contexts.fork(contexts.current)) == Contexts::Invalid && count) dropOldest();
+  nextClock = rsp.clock + interval;
+  if(handle == Contexts::Invalid) return;
+
+  ring[(first + count++) % MaxCheckpoints] = {handle, steps};
+}
+
+auto Timeline::dropOldest() -> void {
+  contexts.free(ring[first].handle);
+  first = (first + 1) % MaxCheckpoints;
+  count--;
+}
+
+auto Timeline::dropNewest() -> void {
+  contexts.free(ring[(first + count - 1) % MaxCheckpoints].handle);
+  count--;
+}
@@ -0,0 +1,99 @@
+auto RSP::Timing::Hazards::capture(const Pipeline& pipeline) -> void {
+  history = pipeline.history;
+  singleIssue = pipeline.singleIssue;
+}
+
+auto RSP::Timing::Hazards::restore(Pipeline& pipeline) const -> void {
+  pipeline.history = history;
+  pipeline.singleIssue = singleIssue;
+}
+
+auto RSP::Timing::Hazards::matches(const Pipeline& pipeline) const -> bool {
+  return history == pipeline.history && singleIssue == pipeline.singleIssue;
+}
+
+//the PC is not part of the key: the same code at another address (e.g. an overlay loaded elsewhere) reuses its blocks
+auto RSP::Timing::index(u32 code, const Pipeline& pipeline) -> u32 {
+  auto& history = pipeline.history;
+  u32 hash = pipeline.singleIssue | history.loads << 1;
+  for(u32 mask : history.rPending) hash = (hash ^ mask) * 0x9e37'79b1;
+  for(u32 mask : history.vPending) hash = (hash ^ mask) * 0x9e37'79b1;
+  return (hash ^ code) >> 24 & Sets - 1;
+}
+
+auto RSP::Timing::code(RSP& self, u32 address) -> u32 {
+  auto& imem = self.imem;
+  auto& code = codes[address >> 2 & 1023];
+  u32 first = address >> Memory::Writable::PageBits & 15;
+  u32 last = address + Window * 4 - 4 >> Memory::Writable::PageBits & 15;
+  if(code.generation[0] == imem.generation[first] && code.generation[1] == imem.generation[last]) return code.hash;
+
+  u32 hash = 0x811c'9dc5;
+  for(u32 n : range(Window)) hash = (hash ^ imem.read<Word>(address + n * 4)) * 0x0100'0193;
+  code = {hash, {imem.generation[first], imem.generation[last]}};
+  return hash;
+}
+
+//starts a block at the PC: an existing one if the code and hazards match (wherever it was recorded), else the least recently used way is recorded over.
+auto RSP::Timing::find(RSP& self) -> void {
+  u32 pc = self.ipu.pc;
+  u32 hash = code(self, pc);
+  auto& set = blocks[index(hash, self.pipeline)];
+  block = nullptr;
+  for(auto& way : set) {
+    if(way.size && way.code == hash && way.in.matches(self.pipeline)) { block = &way; break; }
+  }
+  recording = !block;
+  if(recording) {
+    block = &set[0];
+    for(auto& way : set) if(way.used < block->used) block = &way;
+    block->code = hash;
+    block->size = 0;
+    block->in.capture(self.pipeline);
+  }
+  block->used = ++uses;
+  cursor = 0;
+}
+
+//returns the recorded step for the instruction at the PC, or nullptr if the pipeline model has to run.
+//every step re-checks the instruction words it depends on, so changed code is recorded again from that point.
+auto RSP::Timing::replay(RSP& self, u32 instruction) -> const Step* {
+  if(block && (self.ipu.pc != address || self.clock != clock)) block = nullptr;
+
+  if(!block) find(self);
+  if(recording) return nullptr;
+
+  auto& step = block->steps[cursor];
+  if(step.instruction[0] != instruction
+  || step.lookahead && step.instruction[1] != self.imem.read<Word>(self.ipu.pc + 4)) {
+    block->size = cursor;
+    recording = 1;
+    return nullptr;
+  }
+  cursor++;
+  return &step;
+}
+
+auto RSP::Timing::record(RSP& self, u32 instruction, u32 next, u1 lookahead, u1 paired) -> void {
+  if(!block || !recording) return;
+  auto& step = block->steps[block->size++];
+  step.instruction[0] = instruction;
+  step.instruction[1] = next;
+  step.lookahead = lookahead;
+  step.paired = paired;
+  step.clocks = self.pipeline.clocks;
+  step.out.capture(self.pipeline);
+  cursor = block->size;
+}
+
+auto RSP::Timing::advance(RSP& self, s32 boundary) -> void {
+  if(!block) return;
+  //blocks end after a branch delay slot: 'out.singleIssue' is set on the step that issued the branch
+  if(boundary || cursor == Steps || cursor == block->size && !recording
+  || cursor >= 2 && block->steps[cursor - 2].out.singleIssue) {
+    block = nullptr;
+    return;
+  }
+  address = self.ipu.pc;
+  clock = self.clock;
+}